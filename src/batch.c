@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "misc/misc.h"
+#include "memory/memory.h"
+#include "stage_units/stage_units.h"
+#include "cpu.h"
+#include "driver.h"
+#include "batch.h"
+
+// copies a token of the manifest to the heap
+static char *copyManifestToken(char *token) {
+    char *copy = malloc(strlen(token) + 1);
+    strcpy(copy, token);
+    return copy;
+}
+
+// reads the runs of a batch from a manifest file, every line holds a config file ('-' for the default config), an input
+// program file and optionally a file to write the output of the run to. lines starting with % are comments
+void initBatch(Batch *batch, char *manifestFn) {
+
+    FILE *fp = fopen(manifestFn, "r");
+    if (fp == NULL) {
+        printf("error: could not open batch manifest file, exiting...\n");
+        exitSimulation(1);
+    }
+
+    int capacity = 16;
+    batch->runs = malloc(capacity * sizeof(BatchRun));
+    batch->numRuns = 0;
+    batch->nextRun = 0;
+    pthread_mutex_init(&batch->nextRunLock, NULL);
+
+    char buf[1024];
+    int lineNum = 0;
+
+    while (fgets(buf, sizeof(buf), fp) != NULL) {
+        lineNum++;
+
+        if (buf[0] == '%') {
+            continue;
+        }
+
+        char *savePtr = NULL;
+        char *configFn = strtok_r(buf, " \t\r\n", &savePtr);
+        char *inputFn = strtok_r(NULL, " \t\r\n", &savePtr);
+        char *outputFn = strtok_r(NULL, " \t\r\n", &savePtr);
+
+        // skip empty lines
+        if (!configFn) {
+            continue;
+        }
+
+        if (!inputFn || strtok_r(NULL, " \t\r\n", &savePtr)) {
+            printf("error: expected '<config_file> <input_file> [<output_file>]' in line %i of the batch manifest\n", lineNum);
+            exitSimulation(1);
+        }
+
+        if (batch->numRuns == capacity) {
+            capacity *= 2;
+            batch->runs = realloc(batch->runs, capacity * sizeof(BatchRun));
+        }
+
+        BatchRun *run = &batch->runs[batch->numRuns++];
+        run->configFn = strcmp(configFn, "-") ? copyManifestToken(configFn) : NULL;
+        run->inputFn = copyManifestToken(inputFn);
+        run->outputFn = outputFn ? copyManifestToken(outputFn) : NULL;
+        run->exitStatus = 1;
+        run->numCommittedInsts = 0;
+        run->numCycles = 0;
+    }
+
+    fclose(fp);
+}
+
+// free any elements of the batch stored on the heap
+void teardownBatch(Batch *batch) {
+    if (batch->runs) {
+        for (int i = 0; i < batch->numRuns; i++) {
+            free(batch->runs[i].configFn);
+            free(batch->runs[i].inputFn);
+            free(batch->runs[i].outputFn);
+        }
+        free(batch->runs);
+    }
+
+    pthread_mutex_destroy(&batch->nextRunLock);
+}
+
+// simulates a single run of a batch on the calling thread, with its own output and error handling. a run that hits an
+// error jumps back here without freeing its CPU
+void runBatchEntry(BatchRun *run) {
+
+    SimContext context;
+    context.output = NULL;
+
+    if (run->outputFn) {
+        context.output = fopen(run->outputFn, "w");
+        if (context.output == NULL) {
+            run->exitStatus = 1;
+            return;
+        }
+    }
+
+    Params params;
+    CPU cpu;
+
+    setSimContext(&context);
+
+    int exitStatus;
+    if (setjmp(context.errorJump) == 0) {
+
+        // a missing config would silently fall back to the defaults, which the manifest asks for explicitly with '-'
+        if (run->configFn && access(run->configFn, R_OK) != 0) {
+            printf("error: could not open config file '%s', exiting...\n", run->configFn);
+            exitSimulation(1);
+        }
+
+        readConfig(run->configFn, &params);
+        initCPU(&cpu, &params);
+        processInput(run->inputFn, &cpu);
+
+        printf("initial ");
+        printDataCache(cpu.dataCache);
+
+        exitStatus = executeCPU(&cpu);
+        run->numCommittedInsts = cpu.writebackUnit->numCommittedInsts;
+        run->numCycles = numExecutedCycles(&cpu);
+
+        teardownCPU(&cpu);
+    } else {
+        exitStatus = context.errorStatus;
+    }
+
+    setSimContext(NULL);
+    run->exitStatus = exitStatus;
+
+    if (context.output) {
+        fclose(context.output);
+    }
+}
+
+// takes runs of a batch that have not been started and simulates them until there are none left
+void *batchWorker(void *arg) {
+
+    Batch *batch = arg;
+
+    while (1) {
+        pthread_mutex_lock(&batch->nextRunLock);
+        int runIndex = batch->nextRun++;
+        pthread_mutex_unlock(&batch->nextRunLock);
+
+        if (runIndex >= batch->numRuns) {
+            return NULL;
+        }
+
+        runBatchEntry(&batch->runs[runIndex]);
+    }
+}
+
+// prints a result record for every run of the batch as comma separated values, in the order of the manifest
+void printBatchResults(Batch *batch) {
+
+    printf("run,config,input,status,committed instructions,executed cycles,IPC\n");
+
+    for (int i = 0; i < batch->numRuns; i++) {
+        BatchRun *run = &batch->runs[i];
+        printf("%i,%s,%s,%i,%i,%i,%.4f\n", i, run->configFn ? run->configFn : "-", run->inputFn, run->exitStatus, run->numCommittedInsts,
+            run->numCycles, run->numCycles ? (double) run->numCommittedInsts / run->numCycles : 0.0);
+    }
+}
+
+// simulates every run of a batch manifest on a given number of worker threads (0 for one per processor), and returns
+// 0 if every program finished or 1 otherwise
+int runBatch(char *manifestFn, int numThreads) {
+
+    Batch batch;
+    initBatch(&batch, manifestFn);
+
+    if (numThreads <= 0) {
+        numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (numThreads > batch.numRuns) {
+        numThreads = batch.numRuns;
+    }
+
+    pthread_t *threads = malloc(numThreads * sizeof(pthread_t));
+    for (int i = 0; i < numThreads; i++) {
+        if (pthread_create(&threads[i], NULL, batchWorker, &batch) != 0) {
+            printf("error: could not create batch worker thread, exiting...\n");
+            exitSimulation(1);
+        }
+    }
+    for (int i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    printBatchResults(&batch);
+
+    int exitStatus = 0;
+    for (int i = 0; i < batch.numRuns; i++) {
+        if (batch.runs[i].exitStatus != 0) {
+            exitStatus = 1;
+        }
+    }
+
+    teardownBatch(&batch);
+
+    return exitStatus;
+}
@@ -0,0 +1,28 @@
+#include <pthread.h>
+
+// struct representing a single run of a batch, a program simulated with a config
+typedef struct BatchRun {
+    char *configFn; // NULL for the default config
+    char *inputFn;
+    char *outputFn; // file the simulation output is written to, NULL to discard it
+
+    int exitStatus; // 0 if the program finished, CPU_EXIT_CYCLE_LIMIT if it was stopped, 1 on an error
+    int numCommittedInsts;
+    int numCycles;
+} BatchRun;
+
+// struct representing a batch of runs, worker threads take the next run that has not been started until there are none left
+typedef struct Batch {
+    BatchRun *runs;
+    int numRuns;
+    int nextRun;
+    pthread_mutex_t nextRunLock;
+} Batch;
+
+// batch methods
+void initBatch(Batch *batch, char *manifestFn);
+void teardownBatch(Batch *batch);
+void runBatchEntry(BatchRun *run);
+void *batchWorker(void *arg);
+void printBatchResults(Batch *batch);
+int runBatch(char *manifestFn, int numThreads);
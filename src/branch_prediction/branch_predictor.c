@@ -6,35 +6,317 @@
 #include "branch_predictor.h"
 
 // initialize a branch predictor struct
-void initBranchPredictor(BranchPredictor *branchPredictor) {
+void initBranchPredictor(BranchPredictor *branchPredictor, Params *params) {
+
+    if (params->bpType < BP_TYPE_GLOBAL || params->bpType > BP_TYPE_TAGE) {
+        printf("error: invalid branch predictor type %i\n", params->bpType);
+        exitSimulation(1);
+    }
+
+    if (params->rasSize < 1) {
+        printf("error: the return address stack needs at least 1 entry, got %i\n", params->rasSize);
+        exitSimulation(1);
+    }
+
+    if (params->btbSets < 1 || params->btbWays < 1 || params->btbIndexShift > 30) {
+        printf("error: invalid BTB with %i sets of %i ways indexed from PC bit %i\n", params->btbSets, params->btbWays, params->btbIndexShift);
+        exitSimulation(1);
+    }
+
+    // the gshare index is formed from an unsigned int
+    if (params->bpHistoryLength > 30) {
+        printf("error: branch history length %i is longer than the supported 30 branches\n", params->bpHistoryLength);
+        exitSimulation(1);
+    }
+
+    branchPredictor->type = params->bpType;
     
     // values are specified in the project description
     branchPredictor->state = BRANCH_STATE_WEAKLY_TAKEN; 
-    branchPredictor->numBTBEntries = 16;
+
+    // counters start weakly taken like the global counter
+    branchPredictor->phtSize = params->bpPHTSize;
+    branchPredictor->pht = malloc(branchPredictor->phtSize * sizeof(unsigned char));
+    memset(branchPredictor->pht, 2, branchPredictor->phtSize);
+
+    branchPredictor->gsharePHTSize = params->bpGsharePHTSize;
+    branchPredictor->gsharePHT = malloc(branchPredictor->gsharePHTSize * sizeof(unsigned char));
+    memset(branchPredictor->gsharePHT, 2, branchPredictor->gsharePHTSize);
+
+    // the chooser starts weakly on the bimodal side, which needs less time to warm up
+    branchPredictor->chooserSize = params->bpChooserSize;
+    branchPredictor->chooser = malloc(branchPredictor->chooserSize * sizeof(unsigned char));
+    memset(branchPredictor->chooser, 1, branchPredictor->chooserSize);
+
+    branchPredictor->historyLength = params->bpHistoryLength;
+    branchPredictor->speculativeHistory = 0;
+    branchPredictor->committedHistory = 0;
+
+    // the TAGE base table shares its size with the bimodal table
+    if (branchPredictor->type == BP_TYPE_TAGE) {
+        initTAGEPredictor(&branchPredictor->tage, params->bpPHTSize, params->bpTAGENumTables, params->bpTAGETableSize, params->bpTAGETagBits,
+            params->bpTAGEMinHistory, params->bpTAGEMaxHistory);
+    } else {
+        memset(&branchPredictor->tage, 0, sizeof(TAGEPredictor));
+    }
+
+    initReturnAddressStack(&branchPredictor->speculativeRAS, params->rasSize);
+    initReturnAddressStack(&branchPredictor->committedRAS, params->rasSize);
+
+    branchPredictor->numBranches = 0;
+    branchPredictor->numMispredictions = 0;
+    branchPredictor->numJumps = 0;
+    branchPredictor->numJumpMispredictions = 0;
+    branchPredictor->numReturns = 0;
+    branchPredictor->numReturnMispredictions = 0;
+    branchPredictor->numBTBHits = 0;
+    branchPredictor->numBTBMisses = 0;
+    branchPredictor->numFlushedInsts = 0;
+    branchPredictor->numFlushCycles = 0;
+    branchPredictor->flushCycle = -1;
     
-    branchPredictor->btb = malloc(branchPredictor->numBTBEntries * sizeof(BTBEntry *));
+    branchPredictor->numBTBSets = params->btbSets;
+    branchPredictor->numBTBWays = params->btbWays;
+    branchPredictor->btbIndexShift = params->btbIndexShift;
+    branchPredictor->btb = malloc(params->btbSets * params->btbWays * sizeof(BTBEntry));
+    branchPredictor->btbAccessCounter = 0;
 
-    for (int i = 0; i < branchPredictor->numBTBEntries; i++) {
-        BTBEntry *entry = malloc(sizeof(BTBEntry));
+    for (int i = 0; i < params->btbSets * params->btbWays; i++) {
+        BTBEntry *entry = &branchPredictor->btb[i];
         entry->pc = -1;
         entry->target = -1;
-
-        branchPredictor->btb[i] = entry;
+        entry->lastUsed = 0;
     }
 }
 
 // free any elements of the branch predictor that are stored on the heap
 void teardownBranchPredictor(BranchPredictor *branchPredictor) {
     if (branchPredictor->btb) {
-        for (int i = 0; i < branchPredictor->numBTBEntries; i++) {
-            free(branchPredictor->btb[i]);
-        }
         free(branchPredictor->btb);
     }
+
+    if (branchPredictor->pht) {
+        free(branchPredictor->pht);
+    }
+    if (branchPredictor->gsharePHT) {
+        free(branchPredictor->gsharePHT);
+    }
+    if (branchPredictor->chooser) {
+        free(branchPredictor->chooser);
+    }
+
+    teardownTAGEPredictor(&branchPredictor->tage);
+    teardownReturnAddressStack(&branchPredictor->speculativeRAS);
+    teardownReturnAddressStack(&branchPredictor->committedRAS);
+}
+
+// returns 1 if a 2-bit saturating counter predicts taken
+int counterPredictsTaken(unsigned char counter) {
+    return counter >= 2;
+}
+
+// moves a 2-bit saturating counter towards the direction a branch went
+void updateCounter(unsigned char *counter, int branchWasTaken) {
+    if (branchWasTaken && *counter < 3) {
+        (*counter)++;
+    } else if (!branchWasTaken && *counter > 0) {
+        (*counter)--;
+    }
+}
+
+// returns the entry of a table indexed by PC that a given PC uses, instructions are 4 bytes apart so the low bits are dropped
+int phtIndexForPC(int tableSize, int pc) {
+    return (pc / 4) % tableSize;
+}
+
+// returns the entry of the gshare pattern history table used by a given PC and global history
+int gshareIndexForPC(BranchPredictor *branchPredictor, int pc, unsigned long long history) {
+    unsigned int recentHistory = (unsigned int) (history & ((1ull << branchPredictor->historyLength) - 1));
+    return ((unsigned int) (pc / 4) ^ recentHistory) % branchPredictor->gsharePHTSize;
+}
+
+// returns the global history after a branch in a given direction, only the last 64 directions are kept
+unsigned long long shiftBranchHistory(unsigned long long history, int branchWasTaken) {
+    return (history << 1) | (branchWasTaken ? 1 : 0);
+}
+
+// adds the predicted direction of a fetched branch to the history used by later predictions
+void speculativelyUpdateBranchHistory(BranchPredictor *branchPredictor, int branchWasTaken) {
+    branchPredictor->speculativeHistory = shiftBranchHistory(branchPredictor->speculativeHistory, branchWasTaken);
+}
+
+// drops the predicted directions of flushed branches from the history and the return addresses of flushed calls from
+// the return address stack
+void restoreBranchHistory(BranchPredictor *branchPredictor) {
+    branchPredictor->speculativeHistory = branchPredictor->committedHistory;
+    copyReturnAddressStack(&branchPredictor->speculativeRAS, &branchPredictor->committedRAS);
+}
+
+// initialize an empty return address stack
+void initReturnAddressStack(ReturnAddressStack *ras, int size) {
+    ras->entries = malloc(size * sizeof(int));
+    ras->size = size;
+    ras->top = size - 1;
+    ras->count = 0;
+}
+
+// free any elements of the return address stack that are stored on the heap
+void teardownReturnAddressStack(ReturnAddressStack *ras) {
+    if (ras->entries) {
+        free(ras->entries);
+    }
+}
+
+// pushes the return address of a call, replacing the oldest one if the stack is full
+void pushReturnAddress(ReturnAddressStack *ras, int addr) {
+    ras->top = (ras->top + 1) % ras->size;
+    ras->entries[ras->top] = addr;
+
+    if (ras->count < ras->size) {
+        ras->count++;
+    }
+}
+
+// pops the return address of the most recent call, -1 if the stack is empty
+int popReturnAddress(ReturnAddressStack *ras) {
+
+    if (ras->count == 0) {
+        return -1;
+    }
+
+    int addr = ras->entries[ras->top];
+    ras->top = (ras->top + ras->size - 1) % ras->size;
+    ras->count--;
+
+    return addr;
+}
+
+// copies the contents of a return address stack of the same size into another
+void copyReturnAddressStack(ReturnAddressStack *dest, ReturnAddressStack *src) {
+    memcpy(dest->entries, src->entries, src->size * sizeof(int));
+    dest->top = src->top;
+    dest->count = src->count;
+}
+
+// returns 1 if a register holds return addresses by convention, R1 and R5 like ra and t0 in RISC-V
+int isLinkRegister(ArchRegister *reg) {
+    return reg && reg->regType == ARCH_REG_INT && (reg->num == 1 || reg->num == 5);
+}
+
+// pushes and pops the return address stack for a jump following the RISC-V hints: a jump writing a link register is a
+// call and a jalr reading a link register other than the one it writes is a return. returns the popped return address,
+// -1 if the jump is not a return or the stack was empty
+int applyJumpToReturnAddressStack(ReturnAddressStack *ras, int type, ArchRegister *destReg, ArchRegister *source1Reg, int pc) {
+
+    int returnAddr = -1;
+
+    if (type == JALR && isLinkRegister(source1Reg) && source1Reg != destReg) {
+        returnAddr = popReturnAddress(ras);
+    }
+
+    if (isLinkRegister(destReg)) {
+        pushReturnAddress(ras, pc + 4);
+    }
+
+    return returnAddr;
+}
+
+// predicts the next PC after a fetched jump. jal targets are known from the pre-decoded instruction, returns use the
+// return address stack and other jalr instructions use the last target stored in the BTB
+int predictJumpTarget(BranchPredictor *branchPredictor, DecodedInstruction *decodedInst) {
+
+    int pc = decodedInst->addr;
+    int returnAddr = applyJumpToReturnAddressStack(&branchPredictor->speculativeRAS, decodedInst->type, decodedInst->destReg, decodedInst->source1Reg, pc);
+
+    if (decodedInst->type == JAL) {
+        return decodedInst->branchTarget;
+    } else if (returnAddr != -1) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("return address stack predicted return at pc: %i to: %i\n", pc, returnAddr);
+        #endif
+
+        return returnAddr;
+    }
+
+    BTBEntry *entry = getBTBEntryForPC(branchPredictor, pc);
+    if (entry) {
+        touchBTBEntry(branchPredictor, entry);
+        return entry->target;
+    }
+
+    return pc + 4;
+}
+
+// updates the committed return address stack and the BTB with a committing jump that went to a given target
+void updateJumpPredictor(BranchPredictor *branchPredictor, Instruction *inst, int target, int predictionWasCorrect) {
+
+    branchPredictor->numJumps++;
+    if (!predictionWasCorrect) {
+        branchPredictor->numJumpMispredictions++;
+    }
+
+    int isReturn = inst->type == JALR && isLinkRegister(inst->source1Reg) && inst->source1Reg != inst->destReg;
+    applyJumpToReturnAddressStack(&branchPredictor->committedRAS, inst->type, inst->destReg, inst->source1Reg, inst->addr);
+
+    if (isReturn) {
+        branchPredictor->numReturns++;
+        if (!predictionWasCorrect) {
+            branchPredictor->numReturnMispredictions++;
+        }
+
+    // indirect jumps that are not returns are predicted to go where they went last time
+    } else if (inst->type == JALR) {
+        updateBTBEntry(branchPredictor, inst->addr, target);
+    }
+}
+
+// updates the state of the branch predictor with the outcome of a committing branch, history is the global history
+// the branch was predicted with
+void updateBranchPredictor(BranchPredictor *branchPredictor, int pc, unsigned long long history, int branchWasTaken, int predictionWasCorrect) {
+
+    branchPredictor->numBranches++;
+    if (!predictionWasCorrect) {
+        branchPredictor->numMispredictions++;
+    }
+
+    branchPredictor->committedHistory = shiftBranchHistory(branchPredictor->committedHistory, branchWasTaken);
+
+    if (branchPredictor->type == BP_TYPE_GLOBAL) {
+        updateGlobalBranchState(branchPredictor, predictionWasCorrect);
+        return;
+    } else if (branchPredictor->type == BP_TYPE_TAGE) {
+        updateTAGEPredictor(&branchPredictor->tage, pc, history, branchWasTaken);
+        return;
+    }
+
+    unsigned char *bimodalCounter = &branchPredictor->pht[phtIndexForPC(branchPredictor->phtSize, pc)];
+    unsigned char *gshareCounter = &branchPredictor->gsharePHT[gshareIndexForPC(branchPredictor, pc, history)];
+
+    // the chooser moves towards whichever table was right when only one of them was
+    if (branchPredictor->type == BP_TYPE_TOURNAMENT) {
+        int bimodalWasCorrect = counterPredictsTaken(*bimodalCounter) == branchWasTaken;
+        int gshareWasCorrect = counterPredictsTaken(*gshareCounter) == branchWasTaken;
+
+        if (bimodalWasCorrect != gshareWasCorrect) {
+            updateCounter(&branchPredictor->chooser[phtIndexForPC(branchPredictor->chooserSize, pc)], gshareWasCorrect);
+        }
+    }
+
+    if (branchPredictor->type == BP_TYPE_BIMODAL || branchPredictor->type == BP_TYPE_TOURNAMENT) {
+        updateCounter(bimodalCounter, branchWasTaken);
+    }
+    if (branchPredictor->type == BP_TYPE_GSHARE || branchPredictor->type == BP_TYPE_TOURNAMENT) {
+        updateCounter(gshareCounter, branchWasTaken);
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("updated branch predictor for pc: %i, history: %llx, taken: %i, bimodal counter: %i, gshare counter: %i\n", pc, history, branchWasTaken, 
+        *bimodalCounter, *gshareCounter);
+    #endif
 }
 
-// updates the state of the branch predictor depending on if a branch was taken or not
-void updateBranchPredictor(BranchPredictor *branchPredictor, int branchWasCorrect) {
+// updates the state of the global counter depending on if a branch was predicted correctly or not
+void updateGlobalBranchState(BranchPredictor *branchPredictor, int branchWasCorrect) {
 
     #ifdef ENABLE_DEBUG_LOG
     printf("updating branch predictor state from: %s ", branchPredictionStateToString(branchPredictor->state));
@@ -78,18 +360,62 @@ void updateBranchPredictor(BranchPredictor *branchPredictor, int branchWasCorrec
     #endif
 }
 
-// returns the BTB that a given PC hashes to
+// returns the BTB set that a given PC maps to
+int btbSetForPC(BranchPredictor *branchPredictor, int pc) {
+    return ((unsigned int) pc >> branchPredictor->btbIndexShift) % branchPredictor->numBTBSets;
+}
+
+// returns the BTB entry holding a given PC, NULL if the PC is not in the BTB
 BTBEntry *getBTBEntryForPC(BranchPredictor *branchPredictor, int pc) {
 
-    // use bits 7-4 of the pc to index into the BTB
-    int mask = 0xF0; // 0b11110000 
-    int index = (pc & mask) >> 4;
+    BTBEntry *set = &branchPredictor->btb[btbSetForPC(branchPredictor, pc) * branchPredictor->numBTBWays];
+    for (int way = 0; way < branchPredictor->numBTBWays; way++) {
+        if (set[way].pc == pc) {
+            return &set[way];
+        }
+    }
 
-    return branchPredictor->btb[index];
+    return NULL;
 }
 
-// returns whether or not the branch predictor should take the branch
-int shouldTakeBranch(BranchPredictor *branchPredictor) {
+// marks a BTB entry as the most recently used one in its set
+void touchBTBEntry(BranchPredictor *branchPredictor, BTBEntry *entry) {
+    entry->lastUsed = ++branchPredictor->btbAccessCounter;
+}
+
+// returns the entry to replace in the set a given PC maps to, empty entries are used first and then the least recently used one
+BTBEntry *btbVictimEntry(BranchPredictor *branchPredictor, int pc) {
+
+    BTBEntry *set = &branchPredictor->btb[btbSetForPC(branchPredictor, pc) * branchPredictor->numBTBWays];
+    BTBEntry *victim = &set[0];
+
+    for (int way = 0; way < branchPredictor->numBTBWays; way++) {
+        if (set[way].pc == -1) {
+            return &set[way];
+        }
+        if (set[way].lastUsed < victim->lastUsed) {
+            victim = &set[way];
+        }
+    }
+
+    return victim;
+}
+
+// returns whether or not the branch predictor should take the branch at a given PC
+int shouldTakeBranch(BranchPredictor *branchPredictor, int pc, unsigned long long history) {
+
+    if (branchPredictor->type == BP_TYPE_BIMODAL) {
+        return counterPredictsTaken(branchPredictor->pht[phtIndexForPC(branchPredictor->phtSize, pc)]);
+    } else if (branchPredictor->type == BP_TYPE_GSHARE) {
+        return counterPredictsTaken(branchPredictor->gsharePHT[gshareIndexForPC(branchPredictor, pc, history)]);
+    } else if (branchPredictor->type == BP_TYPE_TOURNAMENT) {
+        if (counterPredictsTaken(branchPredictor->chooser[phtIndexForPC(branchPredictor->chooserSize, pc)])) {
+            return counterPredictsTaken(branchPredictor->gsharePHT[gshareIndexForPC(branchPredictor, pc, history)]);
+        }
+        return counterPredictsTaken(branchPredictor->pht[phtIndexForPC(branchPredictor->phtSize, pc)]);
+    } else if (branchPredictor->type == BP_TYPE_TAGE) {
+        return tagePredictsTaken(&branchPredictor->tage, pc, history);
+    }
     
     if (branchPredictor->state == BRANCH_STATE_STRONGLY_TAKEN || branchPredictor->state == BRANCH_STATE_WEAKLY_TAKEN) {
         return 1;
@@ -103,12 +429,24 @@ int shouldTakeBranch(BranchPredictor *branchPredictor) {
     }
 }
 
-// updates the BTB for a given address and target
+// updates the BTB for a committing branch at a given address with its target, replacing another branch if it is not there
 void updateBTBEntry(BranchPredictor *branchPredictor, int pc, int target) {
 
     BTBEntry *entry = getBTBEntryForPC(branchPredictor, pc);
+    if (entry) {
+        branchPredictor->numBTBHits++;
+    } else {
+        branchPredictor->numBTBMisses++;
+        entry = btbVictimEntry(branchPredictor, pc);
+
+        #ifdef ENABLE_DEBUG_LOG
+        printf("BTB replacing entry for pc: %i with pc: %i in set: %i\n", entry->pc, pc, btbSetForPC(branchPredictor, pc));
+        #endif
+    }
+
     entry->pc = pc;
     entry->target = target;
+    touchBTBEntry(branchPredictor, entry);
 }
 
 // predict the next PC for a given PC
@@ -122,11 +460,12 @@ int predictNextPC(BranchPredictor *branchPredictor, int pc) {
     BTBEntry *entry = getBTBEntryForPC(branchPredictor, pc);
 
 
-    // check if entry matches the given pc
-    if (pc == entry->pc) {
+    // check if there is an entry for the given pc
+    if (entry) {
+        touchBTBEntry(branchPredictor, entry);
 
         // use 2-bit dynamic state to decide to take the branch or not
-        if (shouldTakeBranch(branchPredictor)) {
+        if (shouldTakeBranch(branchPredictor, pc, branchPredictor->speculativeHistory)) {
             #ifdef ENABLE_DEBUG_LOG
             printf("\tentry matches provided pc and predicted to take branch, returning new pc: %i\n", entry->target);
             #endif
@@ -140,7 +479,7 @@ int predictNextPC(BranchPredictor *branchPredictor, int pc) {
             return pc + 4;
         }
     
-    // entry does not match the given pc (it's either a different branch or the entry has not been used before)
+    // no entry matches the given pc (it's either not a branch or the branch has not committed yet or was replaced)
     } else {
         #ifdef ENABLE_DEBUG_LOG
         printf("\tentry does not match provided pc, returning new pc: %i\n", pc + 4);
@@ -153,10 +492,87 @@ int predictNextPC(BranchPredictor *branchPredictor, int pc) {
 // prints the contents of the branch predictor
 void printBranchPredictor(BranchPredictor *branchPredictor) {
     
-    printf("branch predictor: state: %s\n", branchPredictionStateToString(branchPredictor->state));
+    printf("branch predictor: type: %s, state: %s, speculative history: %llx, committed history: %llx\n", branchPredictorTypeToString(branchPredictor->type), 
+        branchPredictionStateToString(branchPredictor->state), branchPredictor->speculativeHistory, branchPredictor->committedHistory);
+
+    for (int i = 0; i < branchPredictor->numBTBSets * branchPredictor->numBTBWays; i++) {
+        BTBEntry *entry = &branchPredictor->btb[i];
+        if (entry->pc != -1) {
+            printf("\tBTB set: %i, way: %i, pc: %i, target: %i\n", i / branchPredictor->numBTBWays, i % branchPredictor->numBTBWays, entry->pc, entry->target);
+        }
+    }
+
+    if (branchPredictor->type == BP_TYPE_TAGE) {
+        printTAGEPredictor(&branchPredictor->tage);
+    }
+}
 
-    for (int i = 0; i < branchPredictor->numBTBEntries; i++) {
-        BTBEntry *entry = branchPredictor->btb[i];
-        printf("\tBTB entry: %i, pc: %i, target: %i\n", i, entry->pc, entry->target);
+// records that the instructions behind a mispredicted branch were flushed in a given cycle
+void startMispredictionFlush(BranchPredictor *branchPredictor, int cycle, int numFlushedInsts) {
+    branchPredictor->numFlushedInsts += numFlushedInsts;
+    branchPredictor->flushCycle = cycle;
+}
+
+// adds the cycles since the last misprediction flush to the flush cost once an instruction from the correct path commits
+void endMispredictionFlush(BranchPredictor *branchPredictor, int cycle) {
+    if (branchPredictor->flushCycle != -1) {
+        branchPredictor->numFlushCycles += cycle - branchPredictor->flushCycle;
+        branchPredictor->flushCycle = -1;
     }
-}
\ No newline at end of file
+}
+
+// prints the statistics collected by the branch predictor
+void printBranchPredictorStats(BranchPredictor *branchPredictor, int numCommittedInsts) {
+    printf("\nbranch predictor statistics (%s):\n", branchPredictorTypeToString(branchPredictor->type));
+    printf("\tcommitted branches: %i\n", branchPredictor->numBranches);
+    printf("\tmispredictions: %i\n", branchPredictor->numMispredictions);
+
+    if (branchPredictor->numBranches > 0) {
+        printf("\tprediction accuracy: %.2f%%\n", 100.0 * (branchPredictor->numBranches - branchPredictor->numMispredictions) / branchPredictor->numBranches);
+    } else {
+        printf("\tprediction accuracy: n/a\n");
+    }
+
+    if (numCommittedInsts > 0) {
+        printf("\tmispredictions per 1000 instructions: %.2f\n", 1000.0 * branchPredictor->numMispredictions / numCommittedInsts);
+    } else {
+        printf("\tmispredictions per 1000 instructions: n/a\n");
+    }
+
+    int numBTBLookups = branchPredictor->numBTBHits + branchPredictor->numBTBMisses;
+    if (numBTBLookups > 0) {
+        printf("\tBTB hits: %i, misses: %i, hit rate: %.2f%%\n", branchPredictor->numBTBHits, branchPredictor->numBTBMisses, 
+            100.0 * branchPredictor->numBTBHits / numBTBLookups);
+    } else {
+        printf("\tBTB hits: 0, misses: 0, hit rate: n/a\n");
+    }
+
+    printf("\tcommitted jumps: %i, mispredicted: %i\n", branchPredictor->numJumps, branchPredictor->numJumpMispredictions);
+    printf("\treturns: %i, mispredicted: %i\n", branchPredictor->numReturns, branchPredictor->numReturnMispredictions);
+
+    int numFlushes = branchPredictor->numMispredictions + branchPredictor->numJumpMispredictions;
+    printf("\tinstructions flushed by mispredictions: %i\n", branchPredictor->numFlushedInsts);
+    if (numFlushes > 0) {
+        printf("\tcycles lost to misprediction flushes: %i (%.2f per misprediction)\n", branchPredictor->numFlushCycles, 
+            (double) branchPredictor->numFlushCycles / numFlushes);
+    } else {
+        printf("\tcycles lost to misprediction flushes: %i\n", branchPredictor->numFlushCycles);
+    }
+}
+
+// converts the branch predictor type enum to a string
+char *branchPredictorTypeToString(int type) {
+    if (type == BP_TYPE_GLOBAL) {
+        return "GLOBAL";
+    } else if (type == BP_TYPE_BIMODAL) {
+        return "BIMODAL";
+    } else if (type == BP_TYPE_GSHARE) {
+        return "GSHARE";
+    } else if (type == BP_TYPE_TOURNAMENT) {
+        return "TOURNAMENT";
+    } else if (type == BP_TYPE_TAGE) {
+        return "TAGE";
+    } else {
+        return "NONE";
+    }
+}
@@ -1,22 +1,111 @@
+#include "tage_predictor.h"
 
-// struct representing an entry in the BTB
+// forward declarations
+typedef struct Params Params;
+typedef struct ArchRegister ArchRegister;
+typedef struct DecodedInstruction DecodedInstruction;
+typedef struct Instruction Instruction;
+
+// schemes that can be used to predict branch directions, numbered as in the config file
+enum BranchPredictorType {
+    BP_TYPE_GLOBAL = 0, // a single 2-bit counter shared by every branch, as specified in the project description
+    BP_TYPE_BIMODAL, // a pattern history table of 2-bit counters indexed by PC
+    BP_TYPE_GSHARE, // a pattern history table indexed by PC xor global branch history
+    BP_TYPE_TOURNAMENT, // bimodal and gshare, with a table of 2-bit counters indexed by PC choosing between them
+    BP_TYPE_TAGE // a bimodal base table backed by tagged tables indexed with geometrically increasing lengths of global history
+};
+
+// struct representing an entry in the BTB, the whole branch address is kept as the tag
 typedef struct BTBEntry {
-    int pc;
+    int pc; // -1 if the entry is empty
     int target;
+    unsigned int lastUsed; // value of the BTB access counter when the entry was last used, for LRU
 } BTBEntry;
 
+// struct representing a circular stack of return addresses pushed by calls and popped by returns, the oldest address is
+// overwritten when it is full
+typedef struct ReturnAddressStack {
+    int *entries;
+    int size;
+    int top; // index of the most recent return address
+    int count;
+} ReturnAddressStack;
+
 // struct representing the branch predictor
 typedef struct BranchPredictor {
-    int state; // enum BranchPredictionState
-    int numBTBEntries;
-    BTBEntry **btb;
+    int type; // enum BranchPredictorType
+    int state; // enum BranchPredictionState, only used by the global scheme
+
+    // 2-bit saturating counters, 0 and 1 predict not taken and 2 and 3 predict taken
+    unsigned char *pht; // indexed by PC
+    int phtSize;
+    unsigned char *gsharePHT; // indexed by PC xor global history
+    int gsharePHTSize;
+    unsigned char *chooser; // indexed by PC, 0 and 1 pick the bimodal prediction and 2 and 3 pick the gshare prediction
+    int chooserSize;
+
+    // directions of the most recent branches, newest in the lowest bit
+    int historyLength; // number of directions used by gshare
+    unsigned long long speculativeHistory; // includes the predicted directions of branches that were fetched but have not committed
+    unsigned long long committedHistory;
+
+    TAGEPredictor tage; // only allocated by the TAGE scheme
+
+    // return addresses of the calls that were fetched and of the calls that committed, the first is repaired from the
+    // second after a flush like the global history
+    ReturnAddressStack speculativeRAS;
+    ReturnAddressStack committedRAS;
+
+    // set-associative BTB, the ways of a set are next to each other
+    int numBTBSets;
+    int numBTBWays;
+    int btbIndexShift; // number of low PC bits skipped when picking a set
+    BTBEntry *btb;
+    unsigned int btbAccessCounter;
+
+    int numBranches; // committed branches
+    int numMispredictions;
+    int numJumps; // committed jal and jalr instructions
+    int numJumpMispredictions;
+    int numReturns; // committed jumps that popped the return address stack
+    int numReturnMispredictions;
+    int numBTBHits; // committed branches and indirect jumps that found their entry in the BTB
+    int numBTBMisses;
+    int numFlushedInsts; // instructions in the ROB behind mispredicted branches
+    int numFlushCycles; // cycles from each branch or jump misprediction being flushed until the next instruction commits
+    int flushCycle; // cycle of the last misprediction flush, -1 once an instruction has committed after it
 } BranchPredictor;
 
 // branch predictor methods
-void initBranchPredictor(BranchPredictor *branchPredictor);
+void initBranchPredictor(BranchPredictor *branchPredictor, Params *params);
 void teardownBranchPredictor(BranchPredictor *branchPredictor);
-void updateBranchPredictor(BranchPredictor *branchPredictor, int branchWasTaken);
-int shouldTakeBranch(BranchPredictor *branchPredictor);
+int counterPredictsTaken(unsigned char counter);
+void updateCounter(unsigned char *counter, int branchWasTaken);
+int phtIndexForPC(int tableSize, int pc);
+int gshareIndexForPC(BranchPredictor *branchPredictor, int pc, unsigned long long history);
+unsigned long long shiftBranchHistory(unsigned long long history, int branchWasTaken);
+void speculativelyUpdateBranchHistory(BranchPredictor *branchPredictor, int branchWasTaken);
+void restoreBranchHistory(BranchPredictor *branchPredictor);
+void updateBranchPredictor(BranchPredictor *branchPredictor, int pc, unsigned long long history, int branchWasTaken, int predictionWasCorrect);
+void initReturnAddressStack(ReturnAddressStack *ras, int size);
+void teardownReturnAddressStack(ReturnAddressStack *ras);
+void pushReturnAddress(ReturnAddressStack *ras, int addr);
+int popReturnAddress(ReturnAddressStack *ras);
+void copyReturnAddressStack(ReturnAddressStack *dest, ReturnAddressStack *src);
+int isLinkRegister(ArchRegister *reg);
+int applyJumpToReturnAddressStack(ReturnAddressStack *ras, int type, ArchRegister *destReg, ArchRegister *source1Reg, int pc); // type = enum InstructionType
+int predictJumpTarget(BranchPredictor *branchPredictor, DecodedInstruction *decodedInst);
+void updateJumpPredictor(BranchPredictor *branchPredictor, Instruction *inst, int target, int predictionWasCorrect);
+void updateGlobalBranchState(BranchPredictor *branchPredictor, int branchWasCorrect);
+int shouldTakeBranch(BranchPredictor *branchPredictor, int pc, unsigned long long history);
 void printBranchPredictor(BranchPredictor *branchPredictor);
+void startMispredictionFlush(BranchPredictor *branchPredictor, int cycle, int numFlushedInsts);
+void endMispredictionFlush(BranchPredictor *branchPredictor, int cycle);
+void printBranchPredictorStats(BranchPredictor *branchPredictor, int numCommittedInsts);
+int btbSetForPC(BranchPredictor *branchPredictor, int pc);
+BTBEntry *getBTBEntryForPC(BranchPredictor *branchPredictor, int pc);
+void touchBTBEntry(BranchPredictor *branchPredictor, BTBEntry *entry);
+BTBEntry *btbVictimEntry(BranchPredictor *branchPredictor, int pc);
 int predictNextPC(BranchPredictor *branchPredictor, int pc);
-void updateBTBEntry(BranchPredictor *branchPredictor, int pc, int target);
\ No newline at end of file
+void updateBTBEntry(BranchPredictor *branchPredictor, int pc, int target);
+char *branchPredictorTypeToString(int type); // type = enum BranchPredictorType
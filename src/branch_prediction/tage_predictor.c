@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../misc/misc.h"
+#include "tage_predictor.h"
+
+// initialize a TAGE predictor struct, history lengths grow geometrically from the shortest to the longest table
+void initTAGEPredictor(TAGEPredictor *tage, int baseSize, int numTables, int tableSize, int tagBits, int minHistoryLength, int maxHistoryLength) {
+
+    // a single entry table would be indexed with no bits of history at all
+    if (numTables < 1 || tableSize < 2 || (tableSize & (tableSize - 1)) != 0) {
+        printf("error: TAGE needs at least 1 table and a table size that is a power of 2 of at least 2, got %i tables of %i entries\n", numTables, tableSize);
+        exitSimulation(1);
+    }
+
+    if (tagBits < 1 || tagBits > 16) {
+        printf("error: TAGE tag width %i is not between 1 and 16 bits\n", tagBits);
+        exitSimulation(1);
+    }
+
+    if (minHistoryLength < 1 || minHistoryLength > maxHistoryLength || maxHistoryLength > TAGE_MAX_HISTORY_LENGTH) {
+        printf("error: TAGE history lengths %i to %i are not between 1 and %i branches\n", minHistoryLength, maxHistoryLength,
+            TAGE_MAX_HISTORY_LENGTH);
+        exitSimulation(1);
+    }
+
+    // base counters start weakly taken like the other predictors
+    tage->baseSize = baseSize;
+    tage->base = malloc(baseSize * sizeof(unsigned char));
+    memset(tage->base, 2, baseSize);
+
+    tage->numTables = numTables;
+    tage->tableSize = tableSize;
+    tage->tagBits = tagBits;
+    tage->indexBits = 0;
+    while ((1 << tage->indexBits) < tableSize) {
+        tage->indexBits++;
+    }
+
+    // find the ratio between consecutive history lengths by bisection, each length is then rounded from the previous one
+    // times the ratio
+    double ratio = 1;
+    if (numTables > 1) {
+        double low = 1;
+        double high = (double) maxHistoryLength / minHistoryLength;
+        for (int i = 0; i < 64; i++) {
+            ratio = (low + high) / 2;
+
+            double length = minHistoryLength;
+            for (int j = 1; j < numTables; j++) {
+                length *= ratio;
+            }
+
+            if (length < maxHistoryLength) {
+                low = ratio;
+            } else {
+                high = ratio;
+            }
+        }
+    }
+
+    tage->tables = malloc(numTables * sizeof(TAGETable));
+    double length = minHistoryLength;
+    for (int i = 0; i < numTables; i++) {
+        TAGETable *table = &tage->tables[i];
+
+        table->historyLength = (int) (length + 0.5);
+        if (table->historyLength > maxHistoryLength) {
+            table->historyLength = maxHistoryLength;
+        }
+        length *= ratio;
+
+        table->entries = malloc(tableSize * sizeof(TAGEEntry));
+        for (int j = 0; j < tableSize; j++) {
+            table->entries[j].tag = TAGE_NO_TAG;
+            table->entries[j].counter = 0;
+            table->entries[j].useful = 0;
+        }
+    }
+
+    tage->numUpdates = 0;
+}
+
+// free any elements of the TAGE predictor that are stored on the heap
+void teardownTAGEPredictor(TAGEPredictor *tage) {
+    if (tage->base) {
+        free(tage->base);
+    }
+
+    if (tage->tables) {
+        for (int i = 0; i < tage->numTables; i++) {
+            free(tage->tables[i].entries);
+        }
+        free(tage->tables);
+    }
+}
+
+// xors the most recent directions of the global history together in chunks of a given number of bits
+unsigned int foldBranchHistory(unsigned long long history, int historyLength, int numBits) {
+
+    if (historyLength < TAGE_MAX_HISTORY_LENGTH) {
+        history &= (1ull << historyLength) - 1;
+    }
+
+    unsigned int folded = 0;
+    for (int i = 0; i < historyLength; i += numBits) {
+        folded ^= (unsigned int) (history & ((1ull << numBits) - 1));
+        history >>= numBits;
+    }
+
+    return folded;
+}
+
+// returns the entry of a tagged table used by a given PC and global history
+int tageIndexForPC(TAGEPredictor *tage, int table, int pc, unsigned long long history) {
+    int historyLength = tage->tables[table].historyLength;
+    return ((unsigned int) (pc / 4) ^ foldBranchHistory(history, historyLength, tage->indexBits)) & (tage->tableSize - 1);
+}
+
+// returns the tag a given PC and global history are stored with in a tagged table. the history is folded twice with
+// different widths so that the tag and the index do not alias in the same way
+unsigned int tageTagForPC(TAGEPredictor *tage, int table, int pc, unsigned long long history) {
+
+    int historyLength = tage->tables[table].historyLength;
+    unsigned int tag = (unsigned int) (pc / 4) ^ foldBranchHistory(history, historyLength, tage->tagBits);
+    if (tage->tagBits > 1) {
+        tag ^= foldBranchHistory(history, historyLength, tage->tagBits - 1) << 1;
+    }
+
+    return tag & ((1u << tage->tagBits) - 1);
+}
+
+// returns the table with the longest history that has an entry for a given PC and global history, only looking at tables
+// with shorter histories than a given table. returns -1 if none match, in which case the base table is used
+int tageProviderTable(TAGEPredictor *tage, int pc, unsigned long long history, int shorterThan) {
+
+    for (int i = shorterThan - 1; i >= 0; i--) {
+        TAGEEntry *entry = &tage->tables[i].entries[tageIndexForPC(tage, i, pc, history)];
+        if (entry->tag == tageTagForPC(tage, i, pc, history)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// returns the direction predicted by a given table, -1 for the base table
+int tageTablePrediction(TAGEPredictor *tage, int table, int pc, unsigned long long history) {
+
+    if (table == -1) {
+        return tage->base[(pc / 4) % tage->baseSize] >= 2;
+    }
+
+    return tage->tables[table].entries[tageIndexForPC(tage, table, pc, history)].counter >= 0;
+}
+
+// returns 1 if the TAGE predictor predicts the branch at a given PC to be taken
+int tagePredictsTaken(TAGEPredictor *tage, int pc, unsigned long long history) {
+    return tageTablePrediction(tage, tageProviderTable(tage, pc, history, tage->numTables), pc, history);
+}
+
+// updates the TAGE predictor with the outcome of a branch, history is the global history it was predicted with
+void updateTAGEPredictor(TAGEPredictor *tage, int pc, unsigned long long history, int branchWasTaken) {
+
+    int provider = tageProviderTable(tage, pc, history, tage->numTables);
+    int prediction = tageTablePrediction(tage, provider, pc, history);
+
+    if (provider == -1) {
+        unsigned char *counter = &tage->base[(pc / 4) % tage->baseSize];
+        if (branchWasTaken && *counter < 3) {
+            (*counter)++;
+        } else if (!branchWasTaken && *counter > 0) {
+            (*counter)--;
+        }
+    } else {
+        TAGEEntry *entry = &tage->tables[provider].entries[tageIndexForPC(tage, provider, pc, history)];
+
+        // the provider is only useful when it predicted differently than the next shorter matching table would have
+        int alternatePrediction = tageTablePrediction(tage, tageProviderTable(tage, pc, history, provider), pc, history);
+        if (prediction != alternatePrediction) {
+            if (prediction == branchWasTaken && entry->useful < 3) {
+                entry->useful++;
+            } else if (prediction != branchWasTaken && entry->useful > 0) {
+                entry->useful--;
+            }
+        }
+
+        if (branchWasTaken && entry->counter < 3) {
+            entry->counter++;
+        } else if (!branchWasTaken && entry->counter > -4) {
+            entry->counter--;
+        }
+    }
+
+    // on a misprediction, allocate an entry in a table with a longer history than the provider. if every candidate entry
+    // is still useful, age them so that a later misprediction can replace one
+    if (prediction != branchWasTaken && provider < tage->numTables - 1) {
+        int allocated = 0;
+        for (int i = provider + 1; i < tage->numTables && !allocated; i++) {
+            TAGEEntry *entry = &tage->tables[i].entries[tageIndexForPC(tage, i, pc, history)];
+            if (entry->useful == 0) {
+                entry->tag = tageTagForPC(tage, i, pc, history);
+                entry->counter = branchWasTaken ? 0 : -1;
+                allocated = 1;
+
+                #ifdef ENABLE_DEBUG_LOG
+                printf("TAGE allocated entry for pc: %i in table: %i with history length: %i\n", pc, i, tage->tables[i].historyLength);
+                #endif
+            }
+        }
+
+        if (!allocated) {
+            for (int i = provider + 1; i < tage->numTables; i++) {
+                tage->tables[i].entries[tageIndexForPC(tage, i, pc, history)].useful--;
+            }
+        }
+    }
+
+    // periodically age every entry so that ones which stopped being useful can be replaced
+    tage->numUpdates++;
+    if (tage->numUpdates % TAGE_USEFUL_RESET_PERIOD == 0) {
+        for (int i = 0; i < tage->numTables; i++) {
+            for (int j = 0; j < tage->tableSize; j++) {
+                tage->tables[i].entries[j].useful >>= 1;
+            }
+        }
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("updated TAGE predictor for pc: %i, history: %llx, taken: %i, provider table: %i, predicted: %i\n", pc, history, branchWasTaken,
+        provider, prediction);
+    #endif
+}
+
+// prints the history lengths and occupancy of the TAGE tables
+void printTAGEPredictor(TAGEPredictor *tage) {
+    for (int i = 0; i < tage->numTables; i++) {
+        int numUseful = 0;
+        for (int j = 0; j < tage->tableSize; j++) {
+            if (tage->tables[i].entries[j].useful > 0) {
+                numUseful++;
+            }
+        }
+
+        printf("\tTAGE table: %i, history length: %i, useful entries: %i/%i\n", i, tage->tables[i].historyLength, numUseful, tage->tableSize);
+    }
+}
@@ -0,0 +1,44 @@
+
+#define TAGE_MAX_HISTORY_LENGTH 64 // the global history is kept in an unsigned long long
+#define TAGE_NO_TAG 0xFFFFFFFF // tag of entries that were never allocated, wider than any real tag
+#define TAGE_USEFUL_RESET_PERIOD (1 << 18) // number of updates after which every useful counter is halved
+
+// struct representing an entry of a tagged TAGE table
+typedef struct TAGEEntry {
+    unsigned int tag;
+    signed char counter; // 3-bit signed counter, -4 to 3, predicts taken when non-negative
+    unsigned char useful; // 2-bit counter, entries are only replaced once it reaches 0
+} TAGEEntry;
+
+// struct representing a TAGE table, tagged with the PC and indexed by the PC and a given number of recent branch directions
+typedef struct TAGETable {
+    TAGEEntry *entries;
+    int historyLength;
+} TAGETable;
+
+// struct representing a TAGE predictor, a bimodal base table of 2-bit counters backed by tagged tables with geometrically
+// increasing history lengths. the matching table with the longest history provides the prediction
+typedef struct TAGEPredictor {
+    unsigned char *base;
+    int baseSize;
+
+    TAGETable *tables; // shortest history first
+    int numTables;
+    int tableSize; // power of 2
+    int indexBits;
+    int tagBits;
+
+    int numUpdates;
+} TAGEPredictor;
+
+// TAGE predictor methods
+void initTAGEPredictor(TAGEPredictor *tage, int baseSize, int numTables, int tableSize, int tagBits, int minHistoryLength, int maxHistoryLength);
+void teardownTAGEPredictor(TAGEPredictor *tage);
+unsigned int foldBranchHistory(unsigned long long history, int historyLength, int numBits);
+int tageIndexForPC(TAGEPredictor *tage, int table, int pc, unsigned long long history);
+unsigned int tageTagForPC(TAGEPredictor *tage, int table, int pc, unsigned long long history);
+int tageProviderTable(TAGEPredictor *tage, int pc, unsigned long long history, int shorterThan);
+int tageTablePrediction(TAGEPredictor *tage, int table, int pc, unsigned long long history);
+int tagePredictsTaken(TAGEPredictor *tage, int pc, unsigned long long history);
+void updateTAGEPredictor(TAGEPredictor *tage, int pc, unsigned long long history, int branchWasTaken);
+void printTAGEPredictor(TAGEPredictor *tage);
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 
 #include "misc/misc.h"
 #include "memory/memory.h"
@@ -18,14 +19,18 @@ void initStallStats(StallStats *stallStats) {
     stallStats->fullROBStalls = 0;
     stallStats->totalCDBOpenings = 0;
     stallStats->utilizedCDBs = 0;
+    stallStats->fullCheckpointStalls = 0;
+    stallStats->fullMSHRStalls = 0;
+    stallStats->fullFetchBufferStalls = 0;
+    stallStats->icacheMissStalls = 0;
 }
 
 // creates a new CPU struct, initializes its data structures and components, and returns it
 void initCPU(CPU *cpu, Params *params) {
 
-    //tracks overall cycles executed and execution completion detection respectively
+    //tracks overall cycles executed and whether execution was cut off by the cycle limit respectively
     cpu->cycle = 1;
-    cpu->consecEmptyROBCycles = 0;
+    cpu->reachedCycleLimit = 0;
 
     // store input parameters
     cpu->params = params;
@@ -40,14 +45,14 @@ void initCPU(CPU *cpu, Params *params) {
    
     // initialize data and instruction memory caches
     cpu->dataCache = malloc(sizeof(DataCache));
-    initDataCache(cpu->dataCache);
+    initDataCache(cpu->dataCache, params);
 
     cpu->instCache = malloc(sizeof(InstCache));
-    initInstCache(cpu->instCache);
+    initInstCache(cpu->instCache, params);
 
     // initialize register file
     cpu->registerFile = malloc(sizeof(RegisterFile));
-    initRegisterFile(cpu->registerFile);
+    initRegisterFile(cpu->registerFile, params->NP + params->NPF);
 
     /* initialize status tables */
     
@@ -58,21 +63,25 @@ void initCPU(CPU *cpu, Params *params) {
     initROBStatusTable(statusTables->robTable, params->NR);
 
     statusTables->resStationTable = malloc(sizeof(ResStationStatusTable));
-    initResStationStatusTable(statusTables->resStationTable);
+    initResStationStatusTable(statusTables->resStationTable, params);
 
     statusTables->regTable = malloc(sizeof(RegisterStatusTable));
     initRegisterStatusTable(statusTables->regTable);
 
+    statusTables->loadStoreQueue = malloc(sizeof(LoadStoreQueue));
+    initLoadStoreQueue(statusTables->loadStoreQueue, params);
+
     /* initialize stage units */
 
     cpu->fetchUnit = malloc(sizeof(FetchUnit));
-    initFetchUnit(cpu->fetchUnit, params->NF);
+    initFetchUnit(cpu->fetchUnit, params->NF, params->NFB, params->ftqSize);
 
     cpu->decodeUnit = malloc(sizeof(DecodeUnit));
-    initDecodeUnit(cpu->decodeUnit, params->NI, params->NW);
+    // instructions are live from decode until commit, so the decode queue and ROB bound how many can exist at once (plus a fetch group of slack)
+    initDecodeUnit(cpu->decodeUnit, params->NI, params->NW, params->NC, params->NP, params->NPF, params->NI + params->NR + params->NF);
 
     cpu->memUnit = malloc(sizeof(MemoryUnit));
-    initMemoryUnit(cpu->memUnit);
+    initMemoryUnit(cpu->memUnit, params);
 
     cpu->writebackUnit = malloc(sizeof(WritebackUnit));
     initWritebackUnit(cpu->writebackUnit, params->NB, params->NR);
@@ -83,33 +92,45 @@ void initCPU(CPU *cpu, Params *params) {
     FunctionalUnits *fus = malloc(sizeof(FunctionalUnits));
     cpu->functionalUnits = fus;
 
-    IntFunctionalUnit *intFU = malloc(sizeof(IntFunctionalUnit));
-    initIntFunctionalUnit(intFU, 1); // latency decribed in project description
-    fus->intFU = intFU;
+    fus->numIntFUs = params->numIntFUs;
+    fus->intFUs = malloc(fus->numIntFUs * sizeof(IntFunctionalUnit));
+    for (int i = 0; i < fus->numIntFUs; i++) {
+        initIntFunctionalUnit(&fus->intFUs[i], params->intLatency);
+    }
 
-    FPFunctionalUnit *fpAddFU = malloc(sizeof(FPFunctionalUnit));
-    initFPFunctionalUnit(fpAddFU, FU_TYPE_FPADD, 3); // latency decribed in project description
-    fus->fpAddFU = fpAddFU;
+    fus->numFPAddFUs = params->numFPAddFUs;
+    fus->fpAddFUs = malloc(fus->numFPAddFUs * sizeof(FPFunctionalUnit));
+    for (int i = 0; i < fus->numFPAddFUs; i++) {
+        initFPFunctionalUnit(&fus->fpAddFUs[i], FU_TYPE_FPADD, params->fpAddLatency);
+    }
 
-    FPFunctionalUnit *fpMulFU = malloc(sizeof(FPFunctionalUnit));
-    initFPFunctionalUnit(fpMulFU, FU_TYPE_FPMUL, 4); // latency decribed in project description
-    fus->fpMulFU = fpMulFU;
+    fus->numFPMulFUs = params->numFPMulFUs;
+    fus->fpMulFUs = malloc(fus->numFPMulFUs * sizeof(FPFunctionalUnit));
+    for (int i = 0; i < fus->numFPMulFUs; i++) {
+        initFPFunctionalUnit(&fus->fpMulFUs[i], FU_TYPE_FPMUL, params->fpMulLatency);
+    }
 
-    FPFunctionalUnit *fpDivFU = malloc(sizeof(FPFunctionalUnit));
-    initFPFunctionalUnit(fpDivFU, FU_TYPE_FPDIV, 8); // latency decribed in project description
-    fus->fpDivFU = fpDivFU;
+    fus->numFPDivFUs = params->numFPDivFUs;
+    fus->fpDivFUs = malloc(fus->numFPDivFUs * sizeof(FPFunctionalUnit));
+    for (int i = 0; i < fus->numFPDivFUs; i++) {
+        initFPFunctionalUnit(&fus->fpDivFUs[i], FU_TYPE_FPDIV, params->fpDivLatency);
+    }
 
-    BUFunctionalUnit *buFU = malloc(sizeof(BUFunctionalUnit));
-    initBUFunctionalUnit(buFU, 1); // latency described in project description
-    fus->buFU = buFU;
+    fus->numBUFUs = params->numBUFUs;
+    fus->buFUs = malloc(fus->numBUFUs * sizeof(BUFunctionalUnit));
+    for (int i = 0; i < fus->numBUFUs; i++) {
+        initBUFunctionalUnit(&fus->buFUs[i], params->buLatency);
+    }
 
-    LSFunctionalUnit *lsFU = malloc(sizeof(LSFunctionalUnit));
-    initLSFunctionalUnit(lsFU, 1); // latency described in project description
-    fus->lsFU = lsFU;
+    fus->numLSFUs = params->numLSFUs;
+    fus->lsFUs = malloc(fus->numLSFUs * sizeof(LSFunctionalUnit));
+    for (int i = 0; i < fus->numLSFUs; i++) {
+        initLSFunctionalUnit(&fus->lsFUs[i], params->lsLatency);
+    }
     
     // initialize branch predictor
     cpu->branchPredictor = malloc(sizeof(BranchPredictor));
-    initBranchPredictor(cpu->branchPredictor);
+    initBranchPredictor(cpu->branchPredictor, params);
 }
 
 // free any elements of the CPU that were stored on the heap
@@ -168,25 +189,43 @@ void teardownCPU(CPU *cpu) {
 
     // free functional units
     if (cpu->functionalUnits) {
-        if (cpu->functionalUnits->intFU) {
-            teardownIntFunctionalUnit(cpu->functionalUnits->intFU);
-            free(cpu->functionalUnits->intFU);
+        FunctionalUnits *fus = cpu->functionalUnits;
+
+        if (fus->intFUs) {
+            for (int i = 0; i < fus->numIntFUs; i++) {
+                teardownIntFunctionalUnit(&fus->intFUs[i]);
+            }
+            free(fus->intFUs);
+        }
+        if (fus->fpAddFUs) {
+            for (int i = 0; i < fus->numFPAddFUs; i++) {
+                teardownFPFunctionalUnit(&fus->fpAddFUs[i]);
+            }
+            free(fus->fpAddFUs);
         }
-        if (cpu->functionalUnits->fpAddFU) {
-            teardownFPFunctionalUnit(cpu->functionalUnits->fpAddFU);
-            free(cpu->functionalUnits->fpAddFU);
+        if (fus->fpMulFUs) {
+            for (int i = 0; i < fus->numFPMulFUs; i++) {
+                teardownFPFunctionalUnit(&fus->fpMulFUs[i]);
+            }
+            free(fus->fpMulFUs);
         }
-        if (cpu->functionalUnits->fpMulFU) {
-            teardownFPFunctionalUnit(cpu->functionalUnits->fpMulFU);
-            free(cpu->functionalUnits->fpMulFU);
+        if (fus->fpDivFUs) {
+            for (int i = 0; i < fus->numFPDivFUs; i++) {
+                teardownFPFunctionalUnit(&fus->fpDivFUs[i]);
+            }
+            free(fus->fpDivFUs);
         }
-        if (cpu->functionalUnits->fpDivFU) {
-            teardownFPFunctionalUnit(cpu->functionalUnits->fpDivFU);
-            free(cpu->functionalUnits->fpDivFU);
+        if (fus->buFUs) {
+            for (int i = 0; i < fus->numBUFUs; i++) {
+                teardownBUFunctionalUnit(&fus->buFUs[i]);
+            }
+            free(fus->buFUs);
         }
-        if (cpu->functionalUnits->lsFU) {
-            teardownLSFunctionalUnit(cpu->functionalUnits->lsFU);
-            free(cpu->functionalUnits->lsFU);
+        if (fus->lsFUs) {
+            for (int i = 0; i < fus->numLSFUs; i++) {
+                teardownLSFunctionalUnit(&fus->lsFUs[i]);
+            }
+            free(fus->lsFUs);
         }
 
         free(cpu->functionalUnits);
@@ -209,6 +248,11 @@ void teardownCPU(CPU *cpu) {
             teardownResStationStatusTable(cpu->statusTables->resStationTable);
             free(cpu->statusTables->resStationTable);
         }
+
+        if (cpu->statusTables->loadStoreQueue) {
+            teardownLoadStoreQueue(cpu->statusTables->loadStoreQueue);
+            free(cpu->statusTables->loadStoreQueue);
+        }
         free(cpu->statusTables);
     }
 
@@ -224,6 +268,7 @@ void printStatusTables(CPU *cpu) {
     printRegisterStatusTable(cpu->statusTables->regTable);
     printROBStatusTable(cpu->statusTables->robTable);
     printResStationStatusTable(cpu->statusTables->resStationTable);
+    printLoadStoreQueue(cpu->statusTables->loadStoreQueue);
 }
 
 // helper method to print the current state of the number of tracked stalls
@@ -231,6 +276,10 @@ void printStallStats(StallStats *stallStats) {
     printf("\nstall statistics:\n");
     printf("\tstalls due to full ROB: %i\n", stallStats->fullROBStalls);
     printf("\tstalls due to full reservation stations: %i\n", stallStats->fullResStationStalls);
+    printf("\tstalls due to no free rename checkpoints: %i\n", stallStats->fullCheckpointStalls);
+    printf("\tstalls due to full MSHRs: %i\n", stallStats->fullMSHRStalls);
+    printf("\tstalls due to full fetch buffer: %i\n", stallStats->fullFetchBufferStalls);
+    printf("\tstalls due to instruction cache misses: %i\n", stallStats->icacheMissStalls);
     printf("\ttotal CDB operations avaialble: %i\n", stallStats->totalCDBOpenings);
     printf("\tutilized CDBs: %i\n", stallStats->utilizedCDBs);
 }
@@ -241,87 +290,236 @@ void cycleFunctionalUnits(CPU *cpu) {
     printf("\nperforming functional unit operations...\n");
     #endif
 
+    FunctionalUnits *fus = cpu->functionalUnits;
+
     // execute INT functional unit operations
-    cycleIntFunctionalUnit(cpu->functionalUnits->intFU, cpu->statusTables);
+    cycleIntFunctionalUnits(fus->intFUs, fus->numIntFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printIntFunctionalUnit(cpu->functionalUnits->intFU);
+    for (int i = 0; i < fus->numIntFUs; i++) {
+        printIntFunctionalUnit(&fus->intFUs[i]);
+    }
     #endif
 
     // execute FPAdd functional unit operations
-    cycleFPFunctionalUnit(cpu->functionalUnits->fpAddFU, cpu->statusTables);
+    cycleFPFunctionalUnits(fus->fpAddFUs, fus->numFPAddFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printFPFunctionalUnit(cpu->functionalUnits->fpAddFU);
+    for (int i = 0; i < fus->numFPAddFUs; i++) {
+        printFPFunctionalUnit(&fus->fpAddFUs[i]);
+    }
     #endif
 
     // execute FPMul functional unit operations
-    cycleFPFunctionalUnit(cpu->functionalUnits->fpMulFU, cpu->statusTables);
+    cycleFPFunctionalUnits(fus->fpMulFUs, fus->numFPMulFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printFPFunctionalUnit(cpu->functionalUnits->fpMulFU);
+    for (int i = 0; i < fus->numFPMulFUs; i++) {
+        printFPFunctionalUnit(&fus->fpMulFUs[i]);
+    }
     #endif
 
     // execute FPDiv functional unit operations
-    cycleFPFunctionalUnit(cpu->functionalUnits->fpDivFU, cpu->statusTables);
+    cycleFPFunctionalUnits(fus->fpDivFUs, fus->numFPDivFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printFPFunctionalUnit(cpu->functionalUnits->fpDivFU);
+    for (int i = 0; i < fus->numFPDivFUs; i++) {
+        printFPFunctionalUnit(&fus->fpDivFUs[i]);
+    }
     #endif
 
     // execute branch unit functional unit operations
-    cycleBUFunctionalUnit(cpu->functionalUnits->buFU, cpu->statusTables);
+    cycleBUFunctionalUnits(fus->buFUs, fus->numBUFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printBUFunctionalUnit(cpu->functionalUnits->buFU);
+    for (int i = 0; i < fus->numBUFUs; i++) {
+        printBUFunctionalUnit(&fus->buFUs[i]);
+    }
     #endif
 
     // execute load/store functional unit operations
-    cycleLSFunctionalUnit(cpu->functionalUnits->lsFU, cpu->statusTables);
+    cycleLSFunctionalUnits(fus->lsFUs, fus->numLSFUs, cpu->statusTables);
     #ifdef ENABLE_DEBUG_LOG
-    printLSFunctionalUnit(cpu->functionalUnits->lsFU);
+    for (int i = 0; i < fus->numLSFUs; i++) {
+        printLSFunctionalUnit(&fus->lsFUs[i]);
+    }
     #endif
 }
 
-// checks to see if the ROB status table is empty, indicating that the program has finished execution
+// checks to see if the program has finished execution, which happens once every instruction has retired and the PC points
+// past the program, so there is nothing left to fetch. a mispredicted branch is still in the ROB when fetch runs off the end
+// of the program on the wrong path, and its flush sets the PC back inside the program
 int executionIsComplete(CPU *cpu) {
 
-    // 2 cycles are required for the first instruction be issued and assigned a ROB entry
-    if (cpu->cycle <= 2) {
-        return 0;
-    // emergency cut off if cpu has reached some maximum number of cycles
-    } else if (cpu->cycle >= 1000000) {
+    // stop a program that has not finished once it has used up its cycles (if there is a limit)
+    if (cpu->params->maxCycles > 0 && cpu->cycle > cpu->params->maxCycles) {
+        cpu->reachedCycleLimit = 1;
         return 1;
     }
-    
-    // track the number of cycles that the ROB is consecutively empty
-    if (isROBEmpty(cpu->statusTables->robTable)) {
-        cpu->consecEmptyROBCycles++; 
-    } else {
-        cpu->consecEmptyROBCycles = 0;
+
+    return isROBEmpty(cpu->statusTables->robTable) && cpu->decodeUnit->numInstsInQueue == 0 && fetchUnitIsEmpty(cpu->fetchUnit) && 
+        !readInstructionCache(cpu->instCache, readRegisterFileInt(cpu->registerFile, PHYS_REG_PC));
+}
+
+// returns the number of upcoming cycles in which no unit can change the state of the CPU, other than operations
+// moving through the stages of the fp functional units. the stall statistic incremented in each of these cycles is
+// returned through stallCounter (NULL if there is none)
+int numIdleCyclesAhead(CPU *cpu, int **stallCounter) {
+
+    ROBStatusTable *robTable = cpu->statusTables->robTable;
+    ResStationStatusTable *resStationTable = cpu->statusTables->resStationTable;
+    FunctionalUnits *functionalUnits = cpu->functionalUnits;
+    MemoryUnit *memUnit = cpu->memUnit;
+    FPFunctionalUnit *fpFUs[] = { functionalUnits->fpAddFUs, functionalUnits->fpMulFUs, functionalUnits->fpDivFUs };
+    int numFPFUs[] = { functionalUnits->numFPAddFUs, functionalUnits->numFPMulFUs, functionalUnits->numFPDivFUs };
+
+    // nothing is in flight, execution is about to complete
+    if (isROBEmpty(robTable)) {
+        return 0;
+    }
+
+    // the writeback unit has an instruction to commit or a result to place on the CDB
+    ROBStatusTableEntry *headEntry = getHeadROBEntry(robTable);
+    if ((headEntry->busy && headEntry->state == INST_STATE_WROTE_RESULT) || getMemoryUnitCurrentResult(memUnit)) {
+        return 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < numFPFUs[i]; j++) {
+            if (getCurrentFPFunctionalUnitResult(&fpFUs[i][j])) {
+                return 0;
+            }
+        }
+    }
+
+    // only the fp functional units are skipped over, any operation in the other units has to be simulated
+    for (int i = 0; i < functionalUnits->numIntFUs; i++) {
+        if (!isIntFunctionalUnitEmpty(&functionalUnits->intFUs[i])) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < functionalUnits->numBUFUs; i++) {
+        if (!isBUFunctionalUnitEmpty(&functionalUnits->buFUs[i])) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < functionalUnits->numLSFUs; i++) {
+        if (!functionalUnits->lsFUs[i].isStalled && !isLSFunctionalUnitEmpty(&functionalUnits->lsFUs[i])) {
+            return 0;
+        }
+    }
+
+    if (!memoryUnitIsIdle(memUnit, functionalUnits->lsFUs, functionalUnits->numLSFUs)) {
+        return 0;
+    }
+
+    // a functional unit can start an instruction (the load/store units are held while the memory unit waits for a store or the data cache)
+    if (resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_INT) || resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_BU) || 
+        resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_FPADD) || resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_FPMUL) || 
+        resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_FPDIV)) {
+        return 0;
+    }
+    if (!memoryUnitIsHoldingLoad(memUnit) && (resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_LOAD) || 
+        resStationsHaveWorkForFunctionalUnit(resStationTable, robTable, FU_TYPE_STORE))) {
+        return 0;
+    }
+
+    if (!decodeUnitIsIdle(cpu->decodeUnit, cpu->fetchUnit->numInstsInBuffer, cpu->statusTables, cpu->stallStats, stallCounter)) {
+        return 0;
+    }
+
+    if (!fetchUnitIsIdle(cpu->fetchUnit, cpu->registerFile, cpu->instCache)) {
+        return 0;
+    }
+
+    // the cycle in which the oldest fp operation reaches its last stage forwards its result, so it can't be skipped
+    int numIdleCycles = INT_MAX;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < numFPFUs[i]; j++) {
+            int cyclesUntilResult = cyclesUntilFPFunctionalUnitResult(&fpFUs[i][j]);
+            if (cyclesUntilResult != -1 && cyclesUntilResult - 1 < numIdleCycles) {
+                numIdleCycles = cyclesUntilResult - 1;
+            }
+        }
+    }
+
+    // the same goes for the cycle in which the data cache returns the value of a load or fills a line
+    int cyclesUntilLoadCompletes = cyclesUntilMemoryUnitLoadCompletes(memUnit);
+    if (cyclesUntilLoadCompletes != -1 && cyclesUntilLoadCompletes - 1 < numIdleCycles) {
+        numIdleCycles = cyclesUntilLoadCompletes - 1;
+    }
+
+    // or the cycle in which fetch can read a line that missed in the instruction cache
+    int cyclesUntilLineReturns = cyclesUntilFetchUnitLineReturns(cpu->fetchUnit);
+    if (cyclesUntilLineReturns != -1 && cyclesUntilLineReturns - 1 < numIdleCycles) {
+        numIdleCycles = cyclesUntilLineReturns - 1;
+    }
+
+    // do not skip past the cycle limit. without one, a CPU that nothing can ever wake up is simulated cycle by cycle
+    if (cpu->params->maxCycles > 0 && numIdleCycles > cpu->params->maxCycles + 1 - cpu->cycle) {
+        numIdleCycles = cpu->params->maxCycles + 1 - cpu->cycle;
+    } else if (numIdleCycles == INT_MAX) {
+        return 0;
+    }
+
+    return numIdleCycles;
+}
+
+// jumps over the upcoming cycles in which no unit can change the state of the CPU, leaving it in the same state
+// (including statistics) as it would be after simulating them one by one
+void skipIdleCycles(CPU *cpu) {
+
+    int *stallCounter = NULL;
+    int numIdleCycles = numIdleCyclesAhead(cpu, &stallCounter);
+
+    if (numIdleCycles <= 0) {
+        return;
     }
 
-    // after an incorrect branch prediction flushes the ROB, it takes 2 cycles to fetch and issue the correct instruction
-    // if the ROB is still empty after this, then execution must be complete
-    return cpu->consecEmptyROBCycles >= 2;
+    #ifdef ENABLE_DEBUG_LOG
+    printf("\nskipping %i idle cycles starting at cycle: %i\n", numIdleCycles, cpu->cycle);
+    #endif
+
+    FunctionalUnits *fus = cpu->functionalUnits;
+    for (int i = 0; i < fus->numFPAddFUs; i++) {
+        advanceFPFunctionalUnit(&fus->fpAddFUs[i], numIdleCycles);
+    }
+    for (int i = 0; i < fus->numFPMulFUs; i++) {
+        advanceFPFunctionalUnit(&fus->fpMulFUs[i], numIdleCycles);
+    }
+    for (int i = 0; i < fus->numFPDivFUs; i++) {
+        advanceFPFunctionalUnit(&fus->fpDivFUs[i], numIdleCycles);
+    }
+    advanceMemoryUnit(cpu->memUnit, numIdleCycles, cpu->stallStats);
+    advanceFetchUnit(cpu->fetchUnit, numIdleCycles, cpu->stallStats);
+
+    if (stallCounter) {
+        *stallCounter += numIdleCycles;
+    }
+
+    cpu->cycle += numIdleCycles;
+}
+
+// returns the number of cycles simulated so far, the cycle counter already points at the cycle after the last one
+int numExecutedCycles(CPU *cpu) {
+    return cpu->cycle - 1;
 }
 
-// start executing instructions on the CPU
-void executeCPU(CPU *cpu) {
+// start executing instructions on the CPU, returns the exit status of the simulator
+int executeCPU(CPU *cpu) {
 
     // infinite loop to cycle the clock until execution finishes
     while (!executionIsComplete(cpu)) {
 
         // perform writeback unit operations
         cycleWritebackUnit(cpu->writebackUnit, cpu->fetchUnit, cpu->decodeUnit, cpu->memUnit, 
-            cpu->statusTables, cpu->functionalUnits, cpu->registerFile, cpu->dataCache, cpu->branchPredictor, cpu->stallStats);
+            cpu->statusTables, cpu->functionalUnits, cpu->registerFile, cpu->dataCache, cpu->branchPredictor, cpu->stallStats, cpu->cycle);
 
         // perform memory unit operations
-        cycleMemoryUnit(cpu->memUnit, cpu->dataCache, cpu->functionalUnits->lsFU, cpu->statusTables);
+        cycleMemoryUnit(cpu->memUnit, cpu->dataCache, cpu->functionalUnits->lsFUs, cpu->functionalUnits->numLSFUs, cpu->statusTables, cpu->stallStats, cpu->cycle);
         
         // perform functional unit operations
         cycleFunctionalUnits(cpu);
 
         // perform decode unit operations
-        cycleDecodeUnit(cpu->decodeUnit, cpu->fetchUnit->fetchBuffer, cpu->fetchUnit->numInstsInBuffer, cpu->statusTables, cpu->registerFile, cpu->stallStats, cpu->labelTable);
+        cycleDecodeUnit(cpu->decodeUnit, cpu->fetchUnit, cpu->statusTables, cpu->registerFile, cpu->stallStats);
         
         // perform fetch unit operations
-        cycleFetchUnit(cpu->fetchUnit, cpu->registerFile, cpu->instCache, cpu->branchPredictor);
+        cycleFetchUnit(cpu->fetchUnit, cpu->registerFile, cpu->instCache, cpu->dataCache, cpu->branchPredictor, cpu->stallStats, cpu->cycle);
         
         // print debug information if enabled
         #ifdef ENABLE_DEBUG_LOG
@@ -340,9 +538,19 @@ void executeCPU(CPU *cpu) {
         #endif
 
         cpu->cycle++;
+
+        // jump straight to the next cycle in which something can happen
+        if (cpu->params->ES) {
+            skipIdleCycles(cpu);
+        }
     }
 
-    cpu->stallStats->totalCDBOpenings = cpu->cycle * cpu->params->NB;
+    int numCycles = numExecutedCycles(cpu);
+    cpu->stallStats->totalCDBOpenings = numCycles * cpu->params->NB;
+
+    if (cpu->reachedCycleLimit) {
+        printf("\nreached the cycle limit of %i cycles before the program finished, stopping...\n", cpu->params->maxCycles);
+    }
 
     printf("\n -- DONE EXECUTION --\n\n");
     printRegisterFile(cpu->registerFile);
@@ -350,7 +558,13 @@ void executeCPU(CPU *cpu) {
     printDataCache(cpu->dataCache);
     printf("\n");
     printStallStats(cpu->stallStats);
-    printf("\nexecuted cycles: %i\n", cpu->cycle);
-
-    teardownCPU(cpu);
+    printFetchUnitStats(cpu->fetchUnit);
+    printInstCacheStats(cpu->instCache);
+    printDataCacheStats(cpu->dataCache);
+    printLoadStoreQueueStats(cpu->statusTables->loadStoreQueue);
+    printBranchPredictorStats(cpu->branchPredictor, cpu->writebackUnit->numCommittedInsts);
+    printf("\ncommitted instructions: %i\n", cpu->writebackUnit->numCommittedInsts);
+    printf("executed cycles: %i\n", numCycles);
+
+    return cpu->reachedCycleLimit ? CPU_EXIT_CYCLE_LIMIT : 0;
 }
\ No newline at end of file
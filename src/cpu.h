@@ -19,11 +19,13 @@ typedef struct BranchPredictor BranchPredictor;
 typedef struct MemoryUnit MemoryUnit;
 typedef struct StallStats StallStats;
 
+#define CPU_EXIT_CYCLE_LIMIT 2 // exit status of the simulator when the program is stopped by the cycle limit
+
 // struct representing the CPU
 typedef struct CPU {
 
     int cycle;
-    int consecEmptyROBCycles;
+    int reachedCycleLimit; // set if execution was stopped by the cycle limit before the program finished
 
     Params *params;
     StallStats *stallStats;
@@ -54,5 +56,8 @@ void cycleFunctionalUnits(CPU *cpu);
 void printStallStats(StallStats *stallStats);
 void printStatusTables(CPU *cpu);
 int executionIsComplete(CPU *cpu);
+int numIdleCyclesAhead(CPU *cpu, int **stallCounter);
+void skipIdleCycles(CPU *cpu);
 
-void executeCPU(CPU *cpu);
\ No newline at end of file
+int numExecutedCycles(CPU *cpu);
+int executeCPU(CPU *cpu);
\ No newline at end of file
@@ -3,8 +3,25 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include "cpu.h"
+#include "driver.h"
+#include "batch.h"
 #include "misc/misc.h"
 #include "memory/memory.h"
+#include "branch_prediction/branch_predictor.h"
+
+// config keys where 0 is a valid value, turning off the feature the key controls or picking the first option
+static const char *zeroValueKeys[] = {"NPF", "ES", "MAX_CYCLES", "L2_SETS", "DRAM_LAT", "PF_DEGREE", "BP_TYPE", "BTB_INDEX_SHIFT"};
+
+// returns 1 if a given config key accepts a value of 0
+int configKeyAcceptsZero(char *key) {
+    for (int i = 0; i < (int) (sizeof(zeroValueKeys) / sizeof(zeroValueKeys[0])); i++) {
+        if (!strcmp(key, zeroValueKeys[i])) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
 
 // populates the params struct with values from a config file
 void readConfig(char *configFn, Params *params) {
@@ -13,12 +30,84 @@ void readConfig(char *configFn, Params *params) {
 
     // setup default parameter values
     params->NF = 4;
+    params->NFB = 16;
+    params->ftqSize = 8;
     params->NI = 16;
     params->NW = 4;
     params->NR = 16;
     params->NB = 4;
-
-    FILE *fp = fopen(configFn, "r");
+    params->NC = 8;
+    params->NP = 32;
+    params->NPF = 0;
+    params->ES = 0;
+    params->maxCycles = 1000000;
+
+    // reservation station counts, unit counts and latencies described in the project description
+    params->numIntStations = 4;
+    params->numLoadStations = 2;
+    params->numStoreStations = 2;
+    params->numFPAddStations = 3;
+    params->numFPMulStations = 3;
+    params->numFPDivStations = 2;
+    params->numBUStations = 2;
+    params->numIntFUs = 1;
+    params->numFPAddFUs = 1;
+    params->numFPMulFUs = 1;
+    params->numFPDivFUs = 1;
+    params->numBUFUs = 1;
+    params->numLSFUs = 1;
+    params->intLatency = 1;
+    params->fpAddLatency = 3;
+    params->fpMulLatency = 4;
+    params->fpDivLatency = 8;
+    params->buLatency = 1;
+    params->lsLatency = 1;
+
+    // a 32 KiB 8-way L1 data cache, misses take as long as hits so timing matches the single cycle memory of the project description
+    params->l1dSets = 64;
+    params->l1dWays = 8;
+    params->l1dLineSize = 64;
+    params->l1dReplacementPolicy = CACHE_REPL_LRU;
+    params->l1dHitLatency = 1;
+    params->l1dMissLatency = 1;
+    params->numMSHRs = 4;
+
+    // a 16 KiB 4-way L1 instruction cache, a miss only costs a single cycle of fetch unless lower levels are modeled
+    params->l1iSets = 64;
+    params->l1iWays = 4;
+    params->l1iLineSize = 64;
+    params->l1iMissLatency = 1;
+
+    // no L2 cache, ideal memory and no prefetcher, so L1 misses only cost the L1 miss latencies
+    params->l2Sets = 0;
+    params->l2Ways = 8;
+    params->l2LineSize = 64;
+    params->l2ReplacementPolicy = CACHE_REPL_LRU;
+    params->l2Latency = 10;
+    params->dramLatency = 0;
+    params->dramRequestsPerCycle = 1;
+    params->prefetchTableSize = 64;
+    params->prefetchBufferSize = 8;
+    params->prefetchDegree = 0;
+    params->prefetchDistance = 1;
+    params->ssitSize = 64;
+    params->numStoreSets = 16;
+    params->bpType = BP_TYPE_GLOBAL;
+    params->bpPHTSize = 1024;
+    params->bpGsharePHTSize = 4096;
+    params->bpChooserSize = 1024;
+    params->bpHistoryLength = 12;
+    params->bpTAGENumTables = 4;
+    params->bpTAGETableSize = 1024;
+    params->bpTAGETagBits = 9;
+    params->bpTAGEMinHistory = 4;
+    params->bpTAGEMaxHistory = 64;
+    params->btbSets = 16;
+    params->btbWays = 1;
+    params->btbIndexShift = 4;
+    params->rasSize = 16;
+
+    FILE *fp = configFn ? fopen(configFn, "r") : NULL;
     if (fp == NULL) {
         printf("could not open config file, using all default values\n");
     } else {
@@ -31,7 +120,7 @@ void readConfig(char *configFn, Params *params) {
         while (fscanf(fp, "%s %d", key, &value) != EOF) {
             // printf("key: %s, value: %d\n", key, value);
 
-            if (value < 1) {
+            if (value < 0 || (value == 0 && !configKeyAcceptsZero(key))) {
                 printf("found invalid value '%d' for key '%s' when reading config, skipping...\n", value, key);
                 continue;
             }
@@ -39,6 +128,10 @@ void readConfig(char *configFn, Params *params) {
             // check each key and see if it's a parameter
             if (!strcmp(key, "NF")) {
                 params->NF = value;
+            } else if (!strcmp(key, "NFB")) {
+                params->NFB = value;
+            } else if (!strcmp(key, "FTQ_SIZE")) {
+                params->ftqSize = value;
             } else if (!strcmp(key, "NI")) {
                 params->NI = value;
             } else if (!strcmp(key, "NW")) {
@@ -47,6 +140,130 @@ void readConfig(char *configFn, Params *params) {
                 params->NR = value;
             } else if (!strcmp(key, "NB")) {
                 params->NB = value;
+            } else if (!strcmp(key, "NC")) {
+                params->NC = value;
+            } else if (!strcmp(key, "NP")) {
+                params->NP = value;
+            } else if (!strcmp(key, "NPF")) {
+                params->NPF = value;
+            } else if (!strcmp(key, "ES")) {
+                params->ES = value;
+            } else if (!strcmp(key, "MAX_CYCLES")) {
+                params->maxCycles = value;
+            } else if (!strcmp(key, "RS_INT")) {
+                params->numIntStations = value;
+            } else if (!strcmp(key, "RS_LOAD")) {
+                params->numLoadStations = value;
+            } else if (!strcmp(key, "RS_STORE")) {
+                params->numStoreStations = value;
+            } else if (!strcmp(key, "RS_FPADD")) {
+                params->numFPAddStations = value;
+            } else if (!strcmp(key, "RS_FPMUL")) {
+                params->numFPMulStations = value;
+            } else if (!strcmp(key, "RS_FPDIV")) {
+                params->numFPDivStations = value;
+            } else if (!strcmp(key, "RS_BU")) {
+                params->numBUStations = value;
+            } else if (!strcmp(key, "FU_INT")) {
+                params->numIntFUs = value;
+            } else if (!strcmp(key, "FU_FPADD")) {
+                params->numFPAddFUs = value;
+            } else if (!strcmp(key, "FU_FPMUL")) {
+                params->numFPMulFUs = value;
+            } else if (!strcmp(key, "FU_FPDIV")) {
+                params->numFPDivFUs = value;
+            } else if (!strcmp(key, "FU_BU")) {
+                params->numBUFUs = value;
+            } else if (!strcmp(key, "FU_LS")) {
+                params->numLSFUs = value;
+            } else if (!strcmp(key, "LAT_INT")) {
+                params->intLatency = value;
+            } else if (!strcmp(key, "LAT_FPADD")) {
+                params->fpAddLatency = value;
+            } else if (!strcmp(key, "LAT_FPMUL")) {
+                params->fpMulLatency = value;
+            } else if (!strcmp(key, "LAT_FPDIV")) {
+                params->fpDivLatency = value;
+            } else if (!strcmp(key, "LAT_BU")) {
+                params->buLatency = value;
+            } else if (!strcmp(key, "LAT_LS")) {
+                params->lsLatency = value;
+            } else if (!strcmp(key, "L1I_SETS")) {
+                params->l1iSets = value;
+            } else if (!strcmp(key, "L1I_WAYS")) {
+                params->l1iWays = value;
+            } else if (!strcmp(key, "L1I_LINE")) {
+                params->l1iLineSize = value;
+            } else if (!strcmp(key, "L1I_MISS_LAT")) {
+                params->l1iMissLatency = value;
+            } else if (!strcmp(key, "L1D_SETS")) {
+                params->l1dSets = value;
+            } else if (!strcmp(key, "L1D_WAYS")) {
+                params->l1dWays = value;
+            } else if (!strcmp(key, "L1D_LINE")) {
+                params->l1dLineSize = value;
+            } else if (!strcmp(key, "L1D_REPL")) {
+                params->l1dReplacementPolicy = value;
+            } else if (!strcmp(key, "L1D_HIT_LAT")) {
+                params->l1dHitLatency = value;
+            } else if (!strcmp(key, "L1D_MISS_LAT")) {
+                params->l1dMissLatency = value;
+            } else if (!strcmp(key, "L1D_MSHRS")) {
+                params->numMSHRs = value;
+            } else if (!strcmp(key, "L2_SETS")) {
+                params->l2Sets = value;
+            } else if (!strcmp(key, "L2_WAYS")) {
+                params->l2Ways = value;
+            } else if (!strcmp(key, "L2_LINE")) {
+                params->l2LineSize = value;
+            } else if (!strcmp(key, "L2_REPL")) {
+                params->l2ReplacementPolicy = value;
+            } else if (!strcmp(key, "L2_LAT")) {
+                params->l2Latency = value;
+            } else if (!strcmp(key, "DRAM_LAT")) {
+                params->dramLatency = value;
+            } else if (!strcmp(key, "DRAM_BW")) {
+                params->dramRequestsPerCycle = value;
+            } else if (!strcmp(key, "PF_TABLE")) {
+                params->prefetchTableSize = value;
+            } else if (!strcmp(key, "PF_BUFFER")) {
+                params->prefetchBufferSize = value;
+            } else if (!strcmp(key, "PF_DEGREE")) {
+                params->prefetchDegree = value;
+            } else if (!strcmp(key, "PF_DISTANCE")) {
+                params->prefetchDistance = value;
+            } else if (!strcmp(key, "SSIT_SIZE")) {
+                params->ssitSize = value;
+            } else if (!strcmp(key, "LFST_SIZE")) {
+                params->numStoreSets = value;
+            } else if (!strcmp(key, "BP_TYPE")) {
+                params->bpType = value;
+            } else if (!strcmp(key, "BP_PHT_SIZE")) {
+                params->bpPHTSize = value;
+            } else if (!strcmp(key, "BP_GSHARE_SIZE")) {
+                params->bpGsharePHTSize = value;
+            } else if (!strcmp(key, "BP_CHOOSER_SIZE")) {
+                params->bpChooserSize = value;
+            } else if (!strcmp(key, "BP_HISTORY")) {
+                params->bpHistoryLength = value;
+            } else if (!strcmp(key, "BP_TAGE_TABLES")) {
+                params->bpTAGENumTables = value;
+            } else if (!strcmp(key, "BP_TAGE_SIZE")) {
+                params->bpTAGETableSize = value;
+            } else if (!strcmp(key, "BP_TAGE_TAG_BITS")) {
+                params->bpTAGETagBits = value;
+            } else if (!strcmp(key, "BP_TAGE_MIN_HIST")) {
+                params->bpTAGEMinHistory = value;
+            } else if (!strcmp(key, "BP_TAGE_MAX_HIST")) {
+                params->bpTAGEMaxHistory = value;
+            } else if (!strcmp(key, "BTB_SETS")) {
+                params->btbSets = value;
+            } else if (!strcmp(key, "BTB_WAYS")) {
+                params->btbWays = value;
+            } else if (!strcmp(key, "BTB_INDEX_SHIFT")) {
+                params->btbIndexShift = value;
+            } else if (!strcmp(key, "RAS_SIZE")) {
+                params->rasSize = value;
             } else {
                 printf("found invalid key '%s', skipping...\n", key);
             }
@@ -55,7 +272,30 @@ void readConfig(char *configFn, Params *params) {
         fclose(fp);
     }
 
-    printf("parameters:\n\tNF = %d\n\tNI = %d\n\tNW = %d\n\tNR = %d\n\tNB = %d\n", params->NF, params->NI, params->NW, params->NR, params->NB);
+    printf("parameters:\n\tNF = %d\n\tNI = %d\n\tNW = %d\n\tNR = %d\n\tNB = %d\n\tNC = %d\n\tNP = %d\n\tNPF = %d\n\tES = %d\n", params->NF, params->NI, params->NW, params->NR, params->NB, params->NC, params->NP, params->NPF, params->ES);
+    printf("\tMAX_CYCLES = %d\n", params->maxCycles);
+    printf("\tNFB = %d\n\tFTQ_SIZE = %d\n", params->NFB, params->ftqSize);
+    printf("\tRS_INT = %d\n\tRS_LOAD = %d\n\tRS_STORE = %d\n\tRS_FPADD = %d\n\tRS_FPMUL = %d\n\tRS_FPDIV = %d\n\tRS_BU = %d\n", params->numIntStations, params->numLoadStations, 
+        params->numStoreStations, params->numFPAddStations, params->numFPMulStations, params->numFPDivStations, params->numBUStations);
+    printf("\tFU_INT = %d\n\tFU_FPADD = %d\n\tFU_FPMUL = %d\n\tFU_FPDIV = %d\n\tFU_BU = %d\n\tFU_LS = %d\n", params->numIntFUs, params->numFPAddFUs, params->numFPMulFUs, 
+        params->numFPDivFUs, params->numBUFUs, params->numLSFUs);
+    printf("\tLAT_INT = %d\n\tLAT_FPADD = %d\n\tLAT_FPMUL = %d\n\tLAT_FPDIV = %d\n\tLAT_BU = %d\n\tLAT_LS = %d\n", params->intLatency, params->fpAddLatency, params->fpMulLatency, 
+        params->fpDivLatency, params->buLatency, params->lsLatency);
+    printf("\tL1I_SETS = %d\n\tL1I_WAYS = %d\n\tL1I_LINE = %d\n\tL1I_MISS_LAT = %d\n", params->l1iSets, params->l1iWays, params->l1iLineSize, 
+        params->l1iMissLatency);
+    printf("\tL1D_SETS = %d\n\tL1D_WAYS = %d\n\tL1D_LINE = %d\n\tL1D_REPL = %s\n\tL1D_HIT_LAT = %d\n\tL1D_MISS_LAT = %d\n\tL1D_MSHRS = %d\n", params->l1dSets, 
+        params->l1dWays, params->l1dLineSize, cacheReplacementPolicyToString(params->l1dReplacementPolicy), params->l1dHitLatency, params->l1dMissLatency, params->numMSHRs);
+    printf("\tL2_SETS = %d\n\tL2_WAYS = %d\n\tL2_LINE = %d\n\tL2_REPL = %s\n\tL2_LAT = %d\n\tDRAM_LAT = %d\n\tDRAM_BW = %d\n", params->l2Sets, params->l2Ways, 
+        params->l2LineSize, cacheReplacementPolicyToString(params->l2ReplacementPolicy), params->l2Latency, params->dramLatency, params->dramRequestsPerCycle);
+    printf("\tPF_TABLE = %d\n\tPF_BUFFER = %d\n\tPF_DEGREE = %d\n\tPF_DISTANCE = %d\n", params->prefetchTableSize, params->prefetchBufferSize, 
+        params->prefetchDegree, params->prefetchDistance);
+    printf("\tSSIT_SIZE = %d\n\tLFST_SIZE = %d\n", params->ssitSize, params->numStoreSets);
+    printf("\tBP_TYPE = %s\n\tBP_PHT_SIZE = %d\n\tBP_GSHARE_SIZE = %d\n\tBP_CHOOSER_SIZE = %d\n\tBP_HISTORY = %d\n", branchPredictorTypeToString(params->bpType), 
+        params->bpPHTSize, params->bpGsharePHTSize, params->bpChooserSize, params->bpHistoryLength);
+    printf("\tBP_TAGE_TABLES = %d\n\tBP_TAGE_SIZE = %d\n\tBP_TAGE_TAG_BITS = %d\n\tBP_TAGE_MIN_HIST = %d\n\tBP_TAGE_MAX_HIST = %d\n", params->bpTAGENumTables, 
+        params->bpTAGETableSize, params->bpTAGETagBits, params->bpTAGEMinHistory, params->bpTAGEMaxHistory);
+    printf("\tBTB_SETS = %d\n\tBTB_WAYS = %d\n\tBTB_INDEX_SHIFT = %d\n\tRAS_SIZE = %d\n", params->btbSets, params->btbWays, params->btbIndexShift,
+        params->rasSize);
 }
 
 // process input file
@@ -66,7 +306,7 @@ void processInput(char *inputFn, CPU *cpu) {
     FILE *fp = fopen(inputFn, "r");
     if (fp == NULL) {
         printf("error: could not open input file, exiting...\n");
-        exit(1);
+        exitSimulation(1);
     }
 
     int bufSize = 1024;
@@ -179,17 +419,32 @@ void processInput(char *inputFn, CPU *cpu) {
     }
     fclose(fp);
 
+    // decode every instruction once now that all labels are known, so that fetch never has to parse strings
+    if (!readError && !decodeInstCache(cpu->instCache, cpu->labelTable)) {
+        readError = 1;
+    }
+
     if (readError) {
         printf("an error was encountered while processing the input file, exiting...\n");
-        exit(1);
+        exitSimulation(1);
     }
 }
 
 int main(int argc, char *argv[]) {
 
+    // batch mode simulates every config and program pair listed in a manifest file on a pool of threads
+    if (argc >= 2 && !strcmp(argv[1], "--batch")) {
+        if (argc < 3 || argc > 4) {
+            printf("error: invalid number of inputs provided\nusage: './cpu_sim --batch <manifest_file> [<num_threads>]'\n");
+            return 1;
+        }
+
+        return runBatch(argv[2], argc == 4 ? atoi(argv[3]) : 0);
+    }
+
     // check number of input files
     if (argc > 3 || argc < 2) {
-        printf("error: invalid number of inputs provided\nusage: './cpu_sim <config_file> <input_file>' or './cpu_sim <input_file>'\n");
+        printf("error: invalid number of inputs provided\nusage: './cpu_sim <config_file> <input_file>', './cpu_sim <input_file>' or './cpu_sim --batch <manifest_file> [<num_threads>]'\n");
         return 1;
     }
 
@@ -215,8 +470,9 @@ int main(int argc, char *argv[]) {
     printf("initial ");
     printDataCache(cpu.dataCache);
 
-    // start executing instructions
-    executeCPU(&cpu);
+    // start executing instructions, the exit status tells whether the program finished or hit the cycle limit
+    int exitStatus = executeCPU(&cpu);
+    teardownCPU(&cpu);
 
-    return 0;
+    return exitStatus;
 }
\ No newline at end of file
@@ -0,0 +1,7 @@
+// forward declarations
+typedef struct Params Params;
+typedef struct CPU CPU;
+
+// driver methods
+void readConfig(char *configFn, Params *params);
+void processInput(char *inputFn, CPU *cpu);
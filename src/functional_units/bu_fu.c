@@ -9,11 +9,17 @@
 // initialize a BU functional unit struct
 void initBUFunctionalUnit(BUFunctionalUnit *buFU, int latency) {
     buFU->latency = latency;
-    buFU->lastSelectedResStation = -1;
     buFU->fuType = FU_TYPE_BU;
     buFU->isStalled = 0;
     buFU->stages = malloc(buFU->latency * sizeof(BUFUResult *)); 
-    buFU->stages[0] = NULL;
+    for (int i = 0; i < buFU->latency; i++) {
+        buFU->stages[i] = NULL;
+    }
+
+    // a result is only referenced while it is in the stages, so one more slot than the latency is never reused too early
+    buFU->numResultSlots = buFU->latency + 1;
+    buFU->resultSlots = calloc(buFU->numResultSlots, sizeof(BUFUResult));
+    buFU->nextResultSlot = 0;
 }
 
 // free any elements of the BU functional unit that are stored on the heap
@@ -21,6 +27,9 @@ void teardownBUFunctionalUnit(BUFunctionalUnit *buFU) {
     if (buFU->stages) {
         free(buFU->stages);
     }
+    if (buFU->resultSlots) {
+        free(buFU->resultSlots);
+    }
 }
 
 // gets the last element in the stages array, which indicates the most recent completed result
@@ -30,7 +39,7 @@ BUFUResult *getCurrentBUFunctionalUnitResult(BUFunctionalUnit *buFU) {
 
 // helper method to print the contents of the BU functional unit
 void printBUFunctionalUnit(BUFunctionalUnit *buFU) {
-    printf("BU functional unit: latency: %i lastSelectedResStation: %i isStalled: %i\n", buFU->latency, buFU->lastSelectedResStation, buFU->isStalled);
+    printf("BU functional unit: latency: %i isStalled: %i\n", buFU->latency, buFU->isStalled);
 
     for (int i = 0; i < buFU->latency; i++) {
         printf("\tstage: %i, ", i);
@@ -40,8 +49,8 @@ void printBUFunctionalUnit(BUFunctionalUnit *buFU) {
         if (!stageElement) {
             printf("NULL\n");
         } else {
-            printf("entry: %p, source1: %i, source2: %i, isBranchTaken: %i, effective address: %i\n", 
-                stageElement, stageElement->source1, stageElement->source2, stageElement->isBranchTaken, stageElement->effAddr);
+            printf("entry: %p, source1: %i, source2: %i, isBranchTaken: %i, effective address: %i, link address: %i\n", 
+                stageElement, stageElement->source1, stageElement->source2, stageElement->isBranchTaken, stageElement->effAddr, stageElement->linkAddr);
         }
     }
 }
@@ -56,8 +65,23 @@ void flushBUFunctionalUnit(BUFunctionalUnit *buFU) {
     buFU->isStalled = 0;
 }
 
-// perform BU functional unit operations over the course of a clock cycle
-void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables) {
+// perform the operations of every BU functional unit over the course of a clock cycle
+void cycleBUFunctionalUnits(BUFunctionalUnit *buFUs, int numBUFUs, StatusTables *statusTables) {
+
+    ResStationStatusTable *resStationTable = statusTables->resStationTable;
+
+    // the units share the reservation stations, each one continues selecting round robin from where the previous one stopped
+    // so that a station is looked at only once per cycle
+    int numResStationsLeft = numResStationsForFunctionalUnit(resStationTable, FU_TYPE_BU);
+    int nextResStation = (*lastSelectedResStationForFunctionalUnit(resStationTable, FU_TYPE_BU) + 1) % numResStationsLeft;
+
+    for (int i = 0; i < numBUFUs; i++) {
+        cycleBUFunctionalUnit(&buFUs[i], statusTables, &nextResStation, &numResStationsLeft);
+    }
+}
+
+// perform BU functional unit operations over the course of a clock cycle, looking at the reservation stations starting at nextResStation
+void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft) {
     printf_DEBUG(("\nperforming BU functional unit operations...\n"));
 
     if (buFU->isStalled) {
@@ -70,21 +94,21 @@ void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables) {
 
     ResStationStatusTableEntry **resStationEntries = resStationEntriesForFunctionalUnit(resStationTable, buFU->fuType);
     int numResStations = numResStationsForFunctionalUnit(resStationTable, buFU->fuType);
-    int nextResStation = (buFU->lastSelectedResStation + 1) % numResStations;
     BUFUResult *nextResult = NULL;
 
-    // iterate over all reservation stations to find the next operands to operate on
-    for (int i = 0; i < numResStations; i++) {
+    // iterate over the reservation stations not yet looked at this cycle to find the next operands to operate on
+    while (*numResStationsLeft > 0) {
 
         // get the reservation station entry's destination ROB and use it to get the assocaited ROB entry
-        ResStationStatusTableEntry *resStationEntry = resStationEntries[nextResStation];
+        ResStationStatusTableEntry *resStationEntry = resStationEntries[*nextResStation];
+        *nextResStation = (*nextResStation + 1) % numResStations;
+        (*numResStationsLeft)--;
         int destROB = resStationEntry->dest;
-        ROBStatusTableEntry *robEntry = robTable->entries[destROB];
+        ROBStatusTableEntry *robEntry = resStationEntry->busy ? &robTable->entries[destROB] : NULL; // free stations have no destination ROB
 
         // do not allow instructions that just received a value from the CDB to execute in the same cycle
         if (resStationEntry->busy && resStationEntry->justGotOperandFromCDB) {
             resStationEntry->justGotOperandFromCDB = 0;
-            nextResStation = (nextResStation + 1) % numResStations;
             continue;
         }
 
@@ -95,19 +119,30 @@ void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables) {
             printf("selecting reservation station: BU[%d] for execution\n", resStationEntry->resStationIndex);
             #endif
             
-            buFU->lastSelectedResStation = nextResStation;
+            *lastSelectedResStationForFunctionalUnit(resStationTable, buFU->fuType) = resStationEntry->resStationIndex;
 
             // update entry in ROB to "executing"
             robEntry->state = INST_STATE_EXECUTING;
 
             // allocate and initialize the next result which will get passed through the stages of the functional unit
-            nextResult = malloc(sizeof(BUFUResult));
+            nextResult = &buFU->resultSlots[buFU->nextResultSlot];
+            buFU->nextResultSlot = (buFU->nextResultSlot + 1) % buFU->numResultSlots;
             nextResult->source1 = resStationEntry->vjInt;
             nextResult->source2 = resStationEntry->vkInt;
             nextResult->destROB = destROB;
+            nextResult->linkAddr = resStationEntry->addr + 4;
             
+            // jumps are always taken, jal targets are relative to the jump and jalr targets to the value of its register
+            // with the lowest bit cleared
+            if (resStationEntry->op == FU_OP_JAL) {
+                nextResult->isBranchTaken = 1;
+                nextResult->effAddr = resStationEntry->addr + resStationEntry->buOffset;
+            } else if (resStationEntry->op == FU_OP_JALR) {
+                nextResult->isBranchTaken = 1;
+                nextResult->effAddr = (resStationEntry->vjInt + resStationEntry->buOffset) & ~1;
+
             // take branch if operands are not equal
-            if (nextResult->source1 != nextResult->source2) {
+            } else if (nextResult->source1 != nextResult->source2) {
                 
                 nextResult->isBranchTaken = 1;
                 nextResult->effAddr = resStationEntry->addr + resStationEntry->buOffset;
@@ -125,8 +160,6 @@ void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables) {
 
             break;
         }
-        
-        nextResStation = (nextResStation + 1) % numResStations;
     }
 
     #ifdef ENABLE_DEBUG_LOG
@@ -136,11 +169,22 @@ void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables) {
     #endif
 
     // move data through the stages of the functional unit by shifting elements of the stages array to the right
-    // this does not do anything given the project design as the stages array is only one element, so it's commented out, but it's good to be general
-    // for (int i = buFU->latency - 1; i >= 1; i--) {
-    //     buFU->stages[i] = buFU->stages[i - 1];
-    // }
+    for (int i = buFU->latency - 1; i >= 1; i--) {
+        buFU->stages[i] = buFU->stages[i - 1];
+    }
 
     // move the next result into the first stage element
     buFU->stages[0] = nextResult;
+}
+
+// returns 1 if there are no operations in any of the stages of the BU functional unit
+int isBUFunctionalUnitEmpty(BUFunctionalUnit *buFU) {
+
+    for (int i = 0; i < buFU->latency; i++) {
+        if (buFU->stages[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
 }
\ No newline at end of file
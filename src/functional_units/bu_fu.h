@@ -5,7 +5,9 @@ typedef struct StatusTables StatusTables;
 
 typedef struct BUFunctionalUnit {
     BUFUResult **stages;
-    int lastSelectedResStation;
+    BUFUResult *resultSlots; // results are recycled from here instead of being allocated every time an operation starts
+    int numResultSlots;
+    int nextResultSlot;
     int latency;
     int fuType; // FunctionalUnitType enum
     int isStalled; // operations get stalled because the writeback unit could not write the result on the CDB
@@ -17,4 +19,6 @@ void teardownBUFunctionalUnit(BUFunctionalUnit *buFU);
 BUFUResult *getCurrentBUFunctionalUnitResult(BUFunctionalUnit *buFU);
 void printBUFunctionalUnit(BUFunctionalUnit *buFU);
 void flushBUFunctionalUnit(BUFunctionalUnit *buFU);
-void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables);
\ No newline at end of file
+void cycleBUFunctionalUnits(BUFunctionalUnit *buFUs, int numBUFUs, StatusTables *statusTables);
+void cycleBUFunctionalUnit(BUFunctionalUnit *buFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft);
+int isBUFunctionalUnitEmpty(BUFunctionalUnit *buFU);
\ No newline at end of file
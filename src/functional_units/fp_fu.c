@@ -9,13 +9,17 @@
 // initialize a floating point functional unit
 void initFPFunctionalUnit(FPFunctionalUnit *fpFU, enum FunctionalUnitType fuType, int latency) {
     fpFU->latency = latency;
-    fpFU->lastSelectedResStation = -1;
     fpFU->fuType = fuType;
     fpFU->isStalled = 0;
     fpFU->stages = malloc(fpFU->latency * sizeof(IntFUResult *)); 
     for (int i = 0; i < fpFU->latency; i++) {
         fpFU->stages[i] = NULL;
     }
+
+    // a result is only referenced while it is in the stages, so one more slot than the latency is never reused too early
+    fpFU->numResultSlots = fpFU->latency + 1;
+    fpFU->resultSlots = calloc(fpFU->numResultSlots, sizeof(FloatFUResult));
+    fpFU->nextResultSlot = 0;
 }
 
 // free any elements of a floating point functional unit that are stored on the heap
@@ -23,6 +27,9 @@ void teardownFPFunctionalUnit(FPFunctionalUnit *fpFU) {
     if (fpFU->stages) {
         free(fpFU->stages);
     }
+    if (fpFU->resultSlots) {
+        free(fpFU->resultSlots);
+    }
 }
 
 // gets the last element in the stages array, which indicates the most recent completed result
@@ -32,7 +39,7 @@ FloatFUResult *getCurrentFPFunctionalUnitResult(FPFunctionalUnit *fpFU) {
 
 // helper method to print the contents of the fp functional unit
 void printFPFunctionalUnit(FPFunctionalUnit *fpFU) {
-    printf("fp functional unit: fuType: %s, latency: %i lastSelectedResStation: %i isStalled: %i\n", fuTypeToString(fpFU->fuType), fpFU->latency, fpFU->lastSelectedResStation, fpFU->isStalled);
+    printf("fp functional unit: fuType: %s, latency: %i isStalled: %i\n", fuTypeToString(fpFU->fuType), fpFU->latency, fpFU->isStalled);
 
     for (int i = 0; i < fpFU->latency; i++) {
         printf("\tstage: %i, ", i);
@@ -56,8 +63,24 @@ void flushFPFunctionalUnit(FPFunctionalUnit *fpFU) {
     fpFU->isStalled = 0;
 }
 
-// perform fp functional unit operations during a cycle
-void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables) {
+// perform the operations of every fp functional unit of one type during a cycle
+void cycleFPFunctionalUnits(FPFunctionalUnit *fpFUs, int numFPFUs, StatusTables *statusTables) {
+
+    ResStationStatusTable *resStationTable = statusTables->resStationTable;
+    enum FunctionalUnitType fuType = fpFUs[0].fuType;
+
+    // the units share the reservation stations, each one continues selecting round robin from where the previous one stopped
+    // so that a station is looked at only once per cycle
+    int numResStationsLeft = numResStationsForFunctionalUnit(resStationTable, fuType);
+    int nextResStation = (*lastSelectedResStationForFunctionalUnit(resStationTable, fuType) + 1) % numResStationsLeft;
+
+    for (int i = 0; i < numFPFUs; i++) {
+        cycleFPFunctionalUnit(&fpFUs[i], statusTables, &nextResStation, &numResStationsLeft);
+    }
+}
+
+// perform fp functional unit operations during a cycle, looking at the reservation stations starting at nextResStation
+void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft) {
     #ifdef ENABLE_DEBUG_LOG
     printf("\nperforming fp functional unit (%s) operations...\n", fuTypeToString(fpFU->fuType));
     #endif
@@ -75,21 +98,21 @@ void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables) {
 
     ResStationStatusTableEntry **resStationEntries = resStationEntriesForFunctionalUnit(resStationTable, fpFU->fuType);
     int numResStations = numResStationsForFunctionalUnit(resStationTable, fpFU->fuType);
-    int nextResStation = (fpFU->lastSelectedResStation + 1) % numResStations;
     FloatFUResult *nextResult = NULL;
 
-    // iterate over all reservation stations to find the next operands to operate on
-    for (int i = 0; i < numResStations; i++) {
+    // iterate over the reservation stations not yet looked at this cycle to find the next operands to operate on
+    while (*numResStationsLeft > 0) {
 
         // get the reservation station entry's destination ROB and use it to get the assocaited ROB entry
-        ResStationStatusTableEntry *resStationEntry = resStationEntries[nextResStation];
+        ResStationStatusTableEntry *resStationEntry = resStationEntries[*nextResStation];
+        *nextResStation = (*nextResStation + 1) % numResStations;
+        (*numResStationsLeft)--;
         int destROB = resStationEntry->dest;
-        ROBStatusTableEntry *robEntry = robTable->entries[destROB];
+        ROBStatusTableEntry *robEntry = resStationEntry->busy ? &robTable->entries[destROB] : NULL; // free stations have no destination ROB
 
         // do not allow instructions that just received a value from the CDB to execute in the same cycle
         if (resStationEntry->busy && resStationEntry->justGotOperandFromCDB) {
             resStationEntry->justGotOperandFromCDB = 0;
-            nextResStation = (nextResStation + 1) % numResStations;
             continue;
         }
 
@@ -100,13 +123,14 @@ void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables) {
             printf("selecting reservation station: %s[%d] for execution\n", fuTypeToString(fpFU->fuType), resStationEntry->resStationIndex);
             #endif
             
-            fpFU->lastSelectedResStation = nextResStation;
+            *lastSelectedResStationForFunctionalUnit(resStationTable, fpFU->fuType) = resStationEntry->resStationIndex;
 
             // update entry in ROB to "executing"
             robEntry->state = INST_STATE_EXECUTING;
 
             // allocate and initialize the next result which will get passed through the stages of the functional unit
-            nextResult = malloc(sizeof(FloatFUResult));
+            nextResult = &fpFU->resultSlots[fpFU->nextResultSlot];
+            fpFU->nextResultSlot = (fpFU->nextResultSlot + 1) % fpFU->numResultSlots;
             nextResult->source1 = resStationEntry->vjFloat;
             nextResult->source2 = resStationEntry->vkFloat;
             nextResult->destROB = destROB;
@@ -130,13 +154,11 @@ void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables) {
                 nextResult->result = nextResult->source1 / nextResult->source2;
             } else {
                 printf("error: tried to start executing an instruction in the fp functional unit with an invalid functional unit type: %s\n", fuTypeToString(fpFU->fuType));
-                exit(1);
+                exitSimulation(1);
             }
 
             break;
         }
-        
-        nextResStation = (nextResStation + 1) % numResStations;
     }
 
     #ifdef ENABLE_DEBUG_LOG
@@ -158,4 +180,24 @@ void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables) {
     if (newestResult) {
         sendFloatUpdateToResStationStatusTable(resStationTable, newestResult->destROB, newestResult->result, 0);
     }
-}
\ No newline at end of file
+}
+
+// returns the number of cycles until the oldest operation in the fp functional unit reaches its last stage, -1 if it is empty
+int cyclesUntilFPFunctionalUnitResult(FPFunctionalUnit *fpFU) {
+
+    for (int i = fpFU->latency - 1; i >= 0; i--) {
+        if (fpFU->stages[i]) {
+            return fpFU->latency - 1 - i;
+        }
+    }
+
+    return -1;
+}
+
+// moves operations through the stages of the fp functional unit over a number of cycles in which none are started
+void advanceFPFunctionalUnit(FPFunctionalUnit *fpFU, int numCycles) {
+
+    for (int i = fpFU->latency - 1; i >= 0; i--) {
+        fpFU->stages[i] = i >= numCycles ? fpFU->stages[i - numCycles] : NULL;
+    }
+}
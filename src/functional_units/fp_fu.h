@@ -5,7 +5,9 @@ typedef struct StatusTables StatusTables;
 
 typedef struct FPFunctionalUnit {
     FloatFUResult **stages;
-    int lastSelectedResStation;
+    FloatFUResult *resultSlots; // results are recycled from here instead of being allocated every time an operation starts
+    int numResultSlots;
+    int nextResultSlot;
     int latency;
     int fuType; // FunctionalUnitType enum
     int isStalled; // operations get stalled because the writeback unit could not write the result on the CDB
@@ -17,4 +19,7 @@ void teardownFPFunctionalUnit(FPFunctionalUnit *fpFU);
 FloatFUResult *getCurrentFPFunctionalUnitResult(FPFunctionalUnit *fpFU);
 void printFPFunctionalUnit(FPFunctionalUnit *fpFU);
 void flushFPFunctionalUnit(FPFunctionalUnit *fpFU);
-void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables);
\ No newline at end of file
+void cycleFPFunctionalUnits(FPFunctionalUnit *fpFUs, int numFPFUs, StatusTables *statusTables);
+void cycleFPFunctionalUnit(FPFunctionalUnit *fpFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft);
+int cyclesUntilFPFunctionalUnitResult(FPFunctionalUnit *fpFU);
+void advanceFPFunctionalUnit(FPFunctionalUnit *fpFU, int numCycles);
\ No newline at end of file
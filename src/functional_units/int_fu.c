@@ -9,11 +9,17 @@
 // initialize a INT functional unit struct
 void initIntFunctionalUnit(IntFunctionalUnit *intFU, int latency) {
     intFU->latency = latency;
-    intFU->lastSelectedResStation = -1;
     intFU->stages = malloc(intFU->latency * sizeof(IntFUResult *)); 
-    intFU->stages[0] = NULL;
+    for (int i = 0; i < intFU->latency; i++) {
+        intFU->stages[i] = NULL;
+    }
     intFU->fuType = FU_TYPE_INT;
     intFU->isStalled = 0;
+
+    // a result is only referenced while it is in the stages, so one more slot than the latency is never reused too early
+    intFU->numResultSlots = intFU->latency + 1;
+    intFU->resultSlots = calloc(intFU->numResultSlots, sizeof(IntFUResult));
+    intFU->nextResultSlot = 0;
 }
 
 // free any INT functional unit elements that are stored on the heap
@@ -21,6 +27,9 @@ void teardownIntFunctionalUnit(IntFunctionalUnit *intFU) {
     if (intFU->stages) {
         free(intFU->stages);
     }
+    if (intFU->resultSlots) {
+        free(intFU->resultSlots);
+    }
 }
 
 // gets the last element in the stages array, which indicates the most recent completed result
@@ -30,7 +39,7 @@ IntFUResult *getCurrentIntFunctionalUnitResult(IntFunctionalUnit *intFU) {
 
 // helper method to print the contents of the int functional unit
 void printIntFunctionalUnit(IntFunctionalUnit *intFU) {
-    printf("int functional unit: latency: %i lastSelectedResStation: %i isStalled: %i\n", intFU->latency, intFU->lastSelectedResStation, intFU->isStalled);
+    printf("int functional unit: latency: %i isStalled: %i\n", intFU->latency, intFU->isStalled);
 
     for (int i = 0; i < intFU->latency; i++) {
         printf("\tstage: %i, ", i);
@@ -56,8 +65,23 @@ void flushIntFunctionalUnit(IntFunctionalUnit *intFU) {
     intFU->isStalled = 0;
 }
 
-// perform INT functional unit operations during a cycle
-void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables) {
+// perform the operations of every INT functional unit during a cycle
+void cycleIntFunctionalUnits(IntFunctionalUnit *intFUs, int numIntFUs, StatusTables *statusTables) {
+
+    ResStationStatusTable *resStationTable = statusTables->resStationTable;
+
+    // the units share the reservation stations, each one continues selecting round robin from where the previous one stopped
+    // so that a station is looked at only once per cycle
+    int numResStationsLeft = numResStationsForFunctionalUnit(resStationTable, FU_TYPE_INT);
+    int nextResStation = (*lastSelectedResStationForFunctionalUnit(resStationTable, FU_TYPE_INT) + 1) % numResStationsLeft;
+
+    for (int i = 0; i < numIntFUs; i++) {
+        cycleIntFunctionalUnit(&intFUs[i], statusTables, &nextResStation, &numResStationsLeft);
+    }
+}
+
+// perform INT functional unit operations during a cycle, looking at the reservation stations starting at nextResStation
+void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft) {
     printf_DEBUG(("\nperforming int functional unit operations...\n"));
 
     if (intFU->isStalled) {
@@ -70,21 +94,21 @@ void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables
 
     ResStationStatusTableEntry **resStationEntries = resStationEntriesForFunctionalUnit(resStationTable, intFU->fuType);
     int numResStations = numResStationsForFunctionalUnit(resStationTable, intFU->fuType);
-    int nextResStation = (intFU->lastSelectedResStation + 1) % numResStations;
     IntFUResult *nextResult = NULL;
 
-    // iterate over all reservation stations to find the next operands to operate on
-    for (int i = 0; i < numResStations; i++) {
+    // iterate over the reservation stations not yet looked at this cycle to find the next operands to operate on
+    while (*numResStationsLeft > 0) {
 
         // get the reservation station entry's destination ROB and use it to get the assocaited ROB entry
-        ResStationStatusTableEntry *resStationEntry = resStationEntries[nextResStation];
+        ResStationStatusTableEntry *resStationEntry = resStationEntries[*nextResStation];
+        *nextResStation = (*nextResStation + 1) % numResStations;
+        (*numResStationsLeft)--;
         int destROB = resStationEntry->dest;
-        ROBStatusTableEntry *robEntry = robTable->entries[destROB];
+        ROBStatusTableEntry *robEntry = resStationEntry->busy ? &robTable->entries[destROB] : NULL; // free stations have no destination ROB
 
         // do not allow instructions that just received a value from the CDB to execute in the same cycle
         if (resStationEntry->busy && resStationEntry->justGotOperandFromCDB) {
             resStationEntry->justGotOperandFromCDB = 0;
-            nextResStation = (nextResStation + 1) % numResStations;
             continue;
         }
 
@@ -95,13 +119,14 @@ void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables
             printf("selecting reservation station: INT[%d] for execution\n", resStationEntry->resStationIndex);
             #endif
             
-            intFU->lastSelectedResStation = nextResStation;
+            *lastSelectedResStationForFunctionalUnit(resStationTable, intFU->fuType) = resStationEntry->resStationIndex;
 
             // update entry in ROB to "executing"
             robEntry->state = INST_STATE_EXECUTING;
 
             // allocate and initialize the next result which will get passed through the stages of the functional unit
-            nextResult = malloc(sizeof(IntFUResult));
+            nextResult = &intFU->resultSlots[intFU->nextResultSlot];
+            intFU->nextResultSlot = (intFU->nextResultSlot + 1) % intFU->numResultSlots;
             nextResult->source1 = resStationEntry->vjInt;
             nextResult->source2 = resStationEntry->vkInt;
             nextResult->destROB = destROB;
@@ -115,13 +140,11 @@ void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables
                 nextResult->result = nextResult->source1 < nextResult->source2;
             } else {
                 printf("error: tried to start executing an instruction in the INT functional unit with an invalid operation\n");
-                exit(1);
+                exitSimulation(1);
             }
 
             break;
         }
-        
-        nextResStation = (nextResStation + 1) % numResStations;
     }
 
     #ifdef ENABLE_DEBUG_LOG
@@ -131,10 +154,9 @@ void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables
     #endif
 
     // move data through the stages of the functional unit by shifting elements of the stages array to the right
-    // this does not do anything given the project design as the stages array is only one element, so it's commented out, but it's good to be general
-    // for (int i = intFU->latency - 1; i >= 1; i--) {
-    //     intFU->stages[i] = intFU->stages[i - 1];
-    // }
+    for (int i = intFU->latency - 1; i >= 1; i--) {
+        intFU->stages[i] = intFU->stages[i - 1];
+    }
 
     // move the next result into the first stage element
     intFU->stages[0] = nextResult;
@@ -144,4 +166,16 @@ void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables
     if (newestResult) {
         sendIntUpdateToResStationStatusTable(resStationTable, newestResult->destROB, newestResult->result, 0);
     }
+}
+
+// returns 1 if there are no operations in any of the stages of the int functional unit
+int isIntFunctionalUnitEmpty(IntFunctionalUnit *intFU) {
+
+    for (int i = 0; i < intFU->latency; i++) {
+        if (intFU->stages[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
 }
\ No newline at end of file
@@ -5,7 +5,9 @@ typedef struct IntFUResult IntFUResult;
 
 typedef struct IntFunctionalUnit {
     IntFUResult **stages;
-    int lastSelectedResStation;
+    IntFUResult *resultSlots; // results are recycled from here instead of being allocated every time an operation starts
+    int numResultSlots;
+    int nextResultSlot;
     int latency;
     int fuType; // FunctionalUnitType enum
     int isStalled; // operations get stalled because the writeback unit could not write the result on the CDB
@@ -17,4 +19,6 @@ void teardownIntFunctionalUnit(IntFunctionalUnit *intFU);
 IntFUResult *getCurrentIntFunctionalUnitResult(IntFunctionalUnit *intFU);
 void printIntFunctionalUnit(IntFunctionalUnit *intFU);
 void flushIntFunctionalUnit(IntFunctionalUnit *intFU);
-void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables);
\ No newline at end of file
+void cycleIntFunctionalUnits(IntFunctionalUnit *intFUs, int numIntFUs, StatusTables *statusTables);
+void cycleIntFunctionalUnit(IntFunctionalUnit *intFU, StatusTables *statusTables, int *nextResStation, int *numResStationsLeft);
+int isIntFunctionalUnitEmpty(IntFunctionalUnit *intFU);
\ No newline at end of file
@@ -10,8 +10,15 @@
 void initLSFunctionalUnit(LSFunctionalUnit *lsFU, int latency) {
     lsFU->latency = latency;
     lsFU->stages = malloc(lsFU->latency * sizeof(LSFUResult *)); 
-    lsFU->stages[0] = NULL;
+    for (int i = 0; i < lsFU->latency; i++) {
+        lsFU->stages[i] = NULL;
+    }
     lsFU->isStalled = 0;
+
+    // a result can be held by the memory unit while the next one is in the stages, so keep one extra slot beyond the number of stages
+    lsFU->numResultSlots = lsFU->latency + 2;
+    lsFU->resultSlots = calloc(lsFU->numResultSlots, sizeof(LSFUResult));
+    lsFU->nextResultSlot = 0;
 }
 
 // free any load/store functional unit elements that are stored on the heap
@@ -19,6 +26,9 @@ void teardownLSFunctionalUnit(LSFunctionalUnit *lsFU) {
     if (lsFU->stages) {
         free(lsFU->stages);
     }
+    if (lsFU->resultSlots) {
+        free(lsFU->resultSlots);
+    }
 }
 
 // gets the last element in the stages array, which indicates the most recent completed result
@@ -54,6 +64,23 @@ void flushLSFunctionalUnit(LSFunctionalUnit *lsFU) {
     lsFU->isStalled = 0;
 }
 
+// perform the operations of every load/store functional unit over a cycle
+void cycleLSFunctionalUnits(LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables) {
+
+    int anyUnitScanned = 0;
+
+    for (int i = 0; i < numLSFUs; i++) {
+        anyUnitScanned |= !lsFUs[i].isStalled;
+        cycleLSFunctionalUnit(&lsFUs[i], statusTables);
+    }
+
+    // reservation stations that just received a value from the CDB were skipped by every unit, they can execute next cycle
+    if (anyUnitScanned) {
+        clearJustGotOperandFromCDBForFunctionalUnit(statusTables->resStationTable, FU_TYPE_LOAD);
+        clearJustGotOperandFromCDBForFunctionalUnit(statusTables->resStationTable, FU_TYPE_STORE);
+    }
+}
+
 // perform load/store functional unit operations over a cycle
 void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables) {
 
@@ -82,11 +109,15 @@ void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables) {
         
         ResStationStatusTableEntry *resStationEntry = loadResStationEntries[i];
         int destROB = resStationEntry->dest;
-        ROBStatusTableEntry *robEntry = robTable->entries[destROB];
+        ROBStatusTableEntry *robEntry = resStationEntry->busy ? &robTable->entries[destROB] : NULL; // free stations have no destination ROB
 
         // do not allow instructions that just received a value from the CDB to execute in the same cycle
         if (resStationEntry->busy && resStationEntry->justGotOperandFromCDB) {
-            resStationEntry->justGotOperandFromCDB = 0;
+            continue;
+        }
+
+        // loads that the store set predictor tied to an older store wait until that store has its address
+        if (resStationEntry->busy && loadIsWaitingForPredictedStore(statusTables->loadStoreQueue, destROB)) {
             continue;
         }
 
@@ -109,11 +140,10 @@ void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables) {
         
         ResStationStatusTableEntry *resStationEntry = storeResStationEntries[i];
         int destROB = resStationEntry->dest;
-        ROBStatusTableEntry *robEntry = robTable->entries[destROB];
+        ROBStatusTableEntry *robEntry = resStationEntry->busy ? &robTable->entries[destROB] : NULL; // free stations have no destination ROB
 
         // do not allow instructions that just received a value from the CDB to execute in the same cycle
         if (resStationEntry->busy && resStationEntry->justGotOperandFromCDB) {
-            resStationEntry->justGotOperandFromCDB = 0;
             continue;
         }
 
@@ -133,6 +163,7 @@ void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables) {
 
     // reservation station entry that will be brought into the functional unit
     ResStationStatusTableEntry *resStationEntry = NULL;
+    LSFUResult *nextResult = NULL;
     
     // check if a reservation station was found to start executing
     if (closestToHeadType != FU_TYPE_NONE) {
@@ -143,33 +174,43 @@ void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables) {
             resStationEntry = storeResStationEntries[closestToHeadResStationIndex];
         } else {
             printf("error: invalid type for finding closest res station to ROB head in LS functional unit, this should never happen\n");
-            exit(1);
+            exitSimulation(1);
         }
+
+        // ROB entry associated with the found reservation station
+        ROBStatusTableEntry *robEntry = &robTable->entries[resStationEntry->dest];
+        robEntry->state = INST_STATE_EXECUTING;
+
+        // perform the address calculation
+        nextResult = &lsFU->resultSlots[lsFU->nextResultSlot];
+        lsFU->nextResultSlot = (lsFU->nextResultSlot + 1) % lsFU->numResultSlots;
+        nextResult->base = resStationEntry->vkInt;
+        nextResult->offset = resStationEntry->addr;
+        nextResult->resultAddr = nextResult->base + nextResult->offset;
+        nextResult->destROB = resStationEntry->dest;
+        nextResult->fuType = closestToHeadType;
+        nextResult->storeValue = resStationEntry->vjFloat;
     } else {
         printf_DEBUG(("no reservation station entries found for LOAD/STORE functional unit\n"));
-
-        lsFU->stages[0] = NULL;
-        return;
     }
 
-    // ROB entry associated with the found reservation station
-    ROBStatusTableEntry *robEntry = robTable->entries[resStationEntry->dest];
-    robEntry->state = INST_STATE_EXECUTING;
-
-    // perform the address calculation
-    LSFUResult *nextResult = malloc(sizeof(LSFUResult));
-    nextResult->base = resStationEntry->vkInt;
-    nextResult->offset = resStationEntry->addr;
-    nextResult->resultAddr = nextResult->base + nextResult->offset;
-    nextResult->destROB = resStationEntry->dest;
-    nextResult->fuType = closestToHeadType;
-
     // move data through the stages of the functional unit by shifting elements of the stages array to the right
-    // this does not do anything given the project design as the stages array is only one element, so it's commented out, but it's good to be general
-    // for (int i = lsFU->latency - 1; i >= 1; i--) {
-    //     lsFU->stages[i] = lsFU->stages[i - 1];
-    // }
+    for (int i = lsFU->latency - 1; i >= 1; i--) {
+        lsFU->stages[i] = lsFU->stages[i - 1];
+    }
 
     // move the next result into the first stage element
     lsFU->stages[0] = nextResult;
+}
+
+// returns 1 if there are no operations in any of the stages of the load/store functional unit
+int isLSFunctionalUnitEmpty(LSFunctionalUnit *lsFU) {
+
+    for (int i = 0; i < lsFU->latency; i++) {
+        if (lsFU->stages[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
 }
\ No newline at end of file
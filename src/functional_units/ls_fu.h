@@ -5,6 +5,9 @@ typedef struct LSFUResult LSFUResult;
 
 typedef struct LSFunctionalUnit {
     LSFUResult **stages;
+    LSFUResult *resultSlots; // results are recycled from here instead of being allocated every time an operation starts
+    int numResultSlots;
+    int nextResultSlot;
     int latency;
     int fuType; // FunctionalUnitType enum
     int isStalled; // operations get stalled because the writeback unit could not write the result on the CDB
@@ -16,4 +19,6 @@ void teardownLSFunctionalUnit(LSFunctionalUnit *lsFU);
 LSFUResult *getCurrentLSFunctionalUnitResult(LSFunctionalUnit *lsFU);
 void printLSFunctionalUnit(LSFunctionalUnit *lsFU);
 void flushLSFunctionalUnit(LSFunctionalUnit *lsFU);
-void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables);
\ No newline at end of file
+void cycleLSFunctionalUnits(LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables);
+void cycleLSFunctionalUnit(LSFunctionalUnit *lsFU, StatusTables *statusTables);
+int isLSFunctionalUnitEmpty(LSFunctionalUnit *lsFU);
\ No newline at end of file
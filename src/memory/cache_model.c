@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../misc/misc.h"
+#include "cache_model.h"
+
+// initialize a struct representing the timing model of a set-associative cache
+void initCacheModel(CacheModel *cache, char *name, int numSets, int numWays, int lineSize, int replacementPolicy, int hitLatency, int missLatency) {
+    #ifdef ENABLE_DEBUG_LOG
+    printf("initalizing %s model: sets: %i, ways: %i, line size: %i, replacement: %s\n", name, numSets, numWays, lineSize, cacheReplacementPolicyToString(replacementPolicy));
+    #endif
+
+    // the pseudo-LRU tree needs every level to split the ways of a set in half
+    if (replacementPolicy == CACHE_REPL_PLRU && (numWays & (numWays - 1)) != 0) {
+        printf("error: %s uses pseudo-LRU replacement which needs a power of 2 number of ways, got %i\n", name, numWays);
+        exitSimulation(1);
+    }
+
+    if (replacementPolicy != CACHE_REPL_LRU && replacementPolicy != CACHE_REPL_PLRU && replacementPolicy != CACHE_REPL_RANDOM) {
+        printf("error: %s has invalid replacement policy %i\n", name, replacementPolicy);
+        exitSimulation(1);
+    }
+
+    cache->name = name;
+    cache->numSets = numSets;
+    cache->numWays = numWays;
+    cache->lineSize = lineSize;
+    cache->replacementPolicy = replacementPolicy;
+    cache->hitLatency = hitLatency;
+    cache->missLatency = missLatency;
+
+    cache->lines = calloc(numSets * numWays, sizeof(CacheLine));
+    cache->plruBits = numWays > 1 ? calloc(numSets * (numWays - 1), sizeof(unsigned char)) : NULL;
+
+    cache->accessCounter = 0;
+    cache->randomState = 2463534242u;
+
+    cache->numHits = 0;
+    cache->numMisses = 0;
+    cache->numLoads = 0;
+    cache->totalLoadCycles = 0;
+}
+
+// free any elements of the cache model stored on the heap
+void teardownCacheModel(CacheModel *cache) {
+    if (cache->lines) {
+        free(cache->lines);
+    }
+
+    if (cache->plruBits) {
+        free(cache->plruBits);
+    }
+}
+
+// returns the set that a given address maps to. addresses are unsigned so the negative addresses of wrong path loads
+// still map to a set inside the cache
+int cacheModelSetIndex(CacheModel *cache, int address) {
+    return ((unsigned int) address / cache->lineSize) % cache->numSets;
+}
+
+// returns the tag stored for a given address
+int cacheModelTag(CacheModel *cache, int address) {
+    return ((unsigned int) address / cache->lineSize) / cache->numSets;
+}
+
+// returns the address of the line containing a given address, in units of lines
+int cacheModelLineAddress(CacheModel *cache, int address) {
+    return (unsigned int) address / cache->lineSize;
+}
+
+// returns 1 if the line containing a given address of an address space is in the cache, without counting an access or
+// updating replacement state
+int cacheModelContainsAddress(CacheModel *cache, int address, int addressSpace) {
+
+    int setIndex = cacheModelSetIndex(cache, address);
+    int tag = cacheModelTag(cache, address);
+    CacheLine *set = &cache->lines[setIndex * cache->numWays];
+
+    for (int way = 0; way < cache->numWays; way++) {
+        if (set[way].valid && set[way].tag == tag && set[way].addressSpace == addressSpace) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// marks a line as the most recently used one in its set
+void touchCacheModelLine(CacheModel *cache, int setIndex, int way) {
+
+    cache->lines[setIndex * cache->numWays + way].lastUsed = ++cache->accessCounter;
+
+    if (cache->replacementPolicy != CACHE_REPL_PLRU || cache->numWays == 1) {
+        return;
+    }
+
+    // walk the tree from the root to the used way, pointing each node at the other half
+    unsigned char *bits = &cache->plruBits[setIndex * (cache->numWays - 1)];
+    int node = 0;
+    int lo = 0;
+    int hi = cache->numWays;
+
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+
+        if (way < mid) {
+            bits[node] = 1;
+            node = 2 * node + 1;
+            hi = mid;
+        } else {
+            bits[node] = 0;
+            node = 2 * node + 2;
+            lo = mid;
+        }
+    }
+}
+
+// returns the way to replace in a given set, invalid lines are always used first
+int cacheModelVictimWay(CacheModel *cache, int setIndex) {
+
+    CacheLine *set = &cache->lines[setIndex * cache->numWays];
+
+    for (int way = 0; way < cache->numWays; way++) {
+        if (!set[way].valid) {
+            return way;
+        }
+    }
+
+    if (cache->replacementPolicy == CACHE_REPL_LRU) {
+        int victim = 0;
+        for (int way = 1; way < cache->numWays; way++) {
+            if (set[way].lastUsed < set[victim].lastUsed) {
+                victim = way;
+            }
+        }
+
+        return victim;
+
+    } else if (cache->replacementPolicy == CACHE_REPL_PLRU) {
+        if (cache->numWays == 1) {
+            return 0;
+        }
+
+        // follow the tree bits down to the pseudo least recently used way
+        unsigned char *bits = &cache->plruBits[setIndex * (cache->numWays - 1)];
+        int node = 0;
+        int lo = 0;
+        int hi = cache->numWays;
+
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+
+            if (bits[node]) {
+                node = 2 * node + 2;
+                lo = mid;
+            } else {
+                node = 2 * node + 1;
+                hi = mid;
+            }
+        }
+
+        return lo;
+
+    } else {
+        unsigned int x = cache->randomState;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        cache->randomState = x;
+
+        return x % cache->numWays;
+    }
+}
+
+// looks up a given address in the cache, filling its line on a miss, and returns the number of cycles the access takes
+int accessCacheModel(CacheModel *cache, int address, int addressSpace) {
+
+    int setIndex = cacheModelSetIndex(cache, address);
+    int tag = cacheModelTag(cache, address);
+    CacheLine *set = &cache->lines[setIndex * cache->numWays];
+
+    for (int way = 0; way < cache->numWays; way++) {
+        if (set[way].valid && set[way].tag == tag && set[way].addressSpace == addressSpace) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("%s hit for address: %i in set: %i way: %i\n", cache->name, address, setIndex, way);
+            #endif
+
+            cache->numHits++;
+            touchCacheModelLine(cache, setIndex, way);
+            return cache->hitLatency;
+        }
+    }
+
+    int victim = cacheModelVictimWay(cache, setIndex);
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("%s miss for address: %i in set: %i, filling way: %i\n", cache->name, address, setIndex, victim);
+    #endif
+
+    cache->numMisses++;
+    set[victim].valid = 1;
+    set[victim].tag = tag;
+    set[victim].addressSpace = addressSpace;
+    touchCacheModelLine(cache, setIndex, victim);
+
+    return cache->missLatency;
+}
+
+// adds the latency of a load that accessed the cache to its statistics
+void recordCacheModelLoad(CacheModel *cache, int cycles) {
+    cache->numLoads++;
+    cache->totalLoadCycles += cycles;
+}
+
+// prints the hit and miss counters of the cache model
+void printCacheModelStats(CacheModel *cache) {
+
+    int numAccesses = cache->numHits + cache->numMisses;
+
+    printf("\n%s statistics:\n", cache->name);
+    printf("\taccesses: %i\n", numAccesses);
+    printf("\thits: %i\n", cache->numHits);
+    printf("\tmisses: %i\n", cache->numMisses);
+    printf("\thit rate: %.2f%%\n", numAccesses ? 100.0 * cache->numHits / numAccesses : 0.0);
+    if (cache->numLoads > 0) {
+        printf("\taverage load latency: %.2f\n", (double) cache->totalLoadCycles / cache->numLoads);
+    }
+}
+
+// converts the cache replacement policy enum to a string
+char *cacheReplacementPolicyToString(int policy) {
+    if (policy == CACHE_REPL_LRU) {
+        return "LRU";
+    } else if (policy == CACHE_REPL_PLRU) {
+        return "PLRU";
+    } else if (policy == CACHE_REPL_RANDOM) {
+        return "RANDOM";
+    } else {
+        return "NONE";
+    }
+}
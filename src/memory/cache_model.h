@@ -0,0 +1,61 @@
+
+// replacement policies that can be used to choose a victim line within a set, numbered as in the config file
+enum CacheReplacementPolicy {
+    CACHE_REPL_NONE = 0,
+    CACHE_REPL_LRU,
+    CACHE_REPL_PLRU,
+    CACHE_REPL_RANDOM
+};
+
+// address spaces a line can belong to, so a unified cache keeps instruction and data lines at the same address apart
+enum CacheAddressSpace {
+    CACHE_ADDR_SPACE_DATA = 0,
+    CACHE_ADDR_SPACE_INST
+};
+
+// struct representing one line of a modeled cache, only the tag is tracked as the data lives in the backing store
+typedef struct CacheLine {
+    int valid;
+    int tag;
+    int addressSpace; // enum CacheAddressSpace
+    unsigned int lastUsed; // value of the access counter when the line was last used, for LRU
+} CacheLine;
+
+// struct representing the timing model of a set-associative cache
+typedef struct CacheModel {
+    char *name; // used when printing statistics
+    int numSets;
+    int numWays;
+    int lineSize;
+    int replacementPolicy; // enum CacheReplacementPolicy
+    int hitLatency;
+    int missLatency;
+
+    // lines of every set, the ways of a set are next to each other
+    CacheLine *lines;
+
+    // tree pseudo-LRU bits, numWays - 1 per set, each bit points towards the half of its subtree to evict from
+    unsigned char *plruBits;
+
+    unsigned int accessCounter;
+    unsigned int randomState; // xorshift state, seeded the same every run so simulations are repeatable
+
+    int numHits;
+    int numMisses;
+    int numLoads;
+    long long totalLoadCycles; // cycles from loads accessing the cache until their data returns, including the levels below
+} CacheModel;
+
+// cache model methods
+void initCacheModel(CacheModel *cache, char *name, int numSets, int numWays, int lineSize, int replacementPolicy, int hitLatency, int missLatency);
+void teardownCacheModel(CacheModel *cache);
+int cacheModelSetIndex(CacheModel *cache, int address);
+int cacheModelTag(CacheModel *cache, int address);
+int cacheModelLineAddress(CacheModel *cache, int address);
+int cacheModelContainsAddress(CacheModel *cache, int address, int addressSpace); // addressSpace = enum CacheAddressSpace
+void touchCacheModelLine(CacheModel *cache, int setIndex, int way);
+int cacheModelVictimWay(CacheModel *cache, int setIndex);
+int accessCacheModel(CacheModel *cache, int address, int addressSpace); // addressSpace = enum CacheAddressSpace
+void recordCacheModelLoad(CacheModel *cache, int cycles);
+void printCacheModelStats(CacheModel *cache);
+char *cacheReplacementPolicyToString(int policy); // policy = enum CacheReplacementPolicy
@@ -2,48 +2,113 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "../misc/misc.h"
+#include "cache_model.h"
+#include "dram_model.h"
+#include "stride_prefetcher.h"
 #include "data_cache.h"
 
 // initialize a struct representing the data cache
-void initDataCache(DataCache *dataCache) {
+void initDataCache(DataCache *dataCache, Params *params) {
     printf_DEBUG(("initalizing data cache...\n"));
 
-    dataCache->cacheSize = DATA_CACHE_INITIAL_SIZE;
-    dataCache->cache = calloc(DATA_CACHE_INITIAL_SIZE, sizeof(float));
+    // second level tables and pages are allocated on first write
+    dataCache->pageDirectory = calloc(DATA_PAGE_DIRECTORY_SIZE, sizeof(float **));
+    dataCache->numPages = 0;
+
+    dataCache->l1Cache = malloc(sizeof(CacheModel));
+    initCacheModel(dataCache->l1Cache, "L1 data cache", params->l1dSets, params->l1dWays, params->l1dLineSize, params->l1dReplacementPolicy, 
+        params->l1dHitLatency, params->l1dMissLatency);
+
+    // every access to the L2 cache takes the same time, a miss then waits for memory
+    dataCache->l2Cache = NULL;
+    if (params->l2Sets > 0) {
+        dataCache->l2Cache = malloc(sizeof(CacheModel));
+        initCacheModel(dataCache->l2Cache, "L2 cache", params->l2Sets, params->l2Ways, params->l2LineSize, params->l2ReplacementPolicy, 
+            params->l2Latency, params->l2Latency);
+    }
+
+    dataCache->dram = NULL;
+    if (params->dramLatency > 0) {
+        dataCache->dram = malloc(sizeof(DRAMModel));
+        initDRAMModel(dataCache->dram, params->dramLatency, params->dramRequestsPerCycle);
+    }
+
+    dataCache->prefetcher = NULL;
+    if (params->prefetchDegree > 0) {
+        dataCache->prefetcher = malloc(sizeof(StridePrefetcher));
+        initStridePrefetcher(dataCache->prefetcher, params->prefetchTableSize, params->prefetchBufferSize, params->prefetchDegree, 
+            params->prefetchDistance);
+    }
 }
 
 // free any elements of the data cache stored on the heap
 void teardownDataCache(DataCache *dataCache) {
-    if (dataCache->cache) {
-        free(dataCache->cache);
+    if (dataCache->pageDirectory) {
+        for (int i = 0; i < DATA_PAGE_DIRECTORY_SIZE; i++) {
+            float **pageTable = dataCache->pageDirectory[i];
+            if (!pageTable) {
+                continue;
+            }
+
+            for (int j = 0; j < DATA_PAGE_TABLE_SIZE; j++) {
+                if (pageTable[j]) {
+                    free(pageTable[j]);
+                }
+            }
+            free(pageTable);
+        }
+        free(dataCache->pageDirectory);
+    }
+
+    if (dataCache->l1Cache) {
+        teardownCacheModel(dataCache->l1Cache);
+        free(dataCache->l1Cache);
+    }
+
+    if (dataCache->l2Cache) {
+        teardownCacheModel(dataCache->l2Cache);
+        free(dataCache->l2Cache);
+    }
+
+    if (dataCache->dram) {
+        free(dataCache->dram);
+    }
+
+    if (dataCache->prefetcher) {
+        teardownStridePrefetcher(dataCache->prefetcher);
+        free(dataCache->prefetcher);
     }
 }
 
-// checks if a given address is outside the bounds of the data cache and increases its size if so
-void extendDataCacheIfNeeded(DataCache *dataCache, int address) {
-    
-    if (address >= dataCache->cacheSize) {
+// returns the page holding a given address, pages that were never written are only allocated if requested and NULL otherwise
+float *dataCachePageForAddress(DataCache *dataCache, int address, int allocate) {
 
-        int oldSize = dataCache->cacheSize;
-        float *oldCache = dataCache->cache;
+    int pageNum = address >> DATA_PAGE_BITS;
+    int directoryIndex = pageNum >> DATA_PAGE_TABLE_BITS;
+    int tableIndex = pageNum & (DATA_PAGE_TABLE_SIZE - 1);
 
-        // double size of data cache until it can fit the requested address
-        int newSize = oldSize * 2;
-        while (newSize <= address) {
-            newSize *= 2;
+    float **pageTable = dataCache->pageDirectory[directoryIndex];
+    if (!pageTable) {
+        if (!allocate) {
+            return NULL;
         }
 
-        // set the new size and reallocate the data cache
-        dataCache->cacheSize = newSize;
-        dataCache->cache = calloc(newSize, sizeof(float));
-        memcpy(dataCache->cache, oldCache, oldSize);
-        free(oldCache);
-        
+        pageTable = calloc(DATA_PAGE_TABLE_SIZE, sizeof(float *));
+        dataCache->pageDirectory[directoryIndex] = pageTable;
+    }
+
+    if (!pageTable[tableIndex] && allocate) {
+        pageTable[tableIndex] = calloc(DATA_PAGE_SIZE, sizeof(float));
+        dataCache->numPages++;
+
         #ifdef ENABLE_DEBUG_LOG
-        printf("address '%d' is greater than the current data cache size '%d', extending to %d entries\n", address, oldSize, newSize);
+        printf("allocated data cache page for addresses %d to %d, %d pages in use\n", pageNum * DATA_PAGE_SIZE, pageNum * DATA_PAGE_SIZE + DATA_PAGE_SIZE - 1, dataCache->numPages);
         #endif
     }
+
+    return pageTable[tableIndex];
 }
 
 // write a float to the given address in the data cache
@@ -54,11 +119,11 @@ void writeFloatToDataCache(DataCache *dataCache, int address, float value) {
         return;
     }
 
-    // check if requested address is outside current cache size
-    extendDataCacheIfNeeded(dataCache, address);
+    // the page is allocated the first time it is written to
+    float *page = dataCachePageForAddress(dataCache, address, 1);
 
     // write the value to the entry
-    dataCache->cache[address] = value;
+    page[address & (DATA_PAGE_SIZE - 1)] = value;
 }
 
 // retrieves a float from a certain address in the data cache
@@ -69,14 +134,17 @@ float readFloatFromDataCache(DataCache *dataCache, int address) {
         return 0;
     }
 
-    // check if requested address is outside current cache size
-    extendDataCacheIfNeeded(dataCache, address);
+    // addresses in pages that were never written still hold 0
+    float *page = dataCachePageForAddress(dataCache, address, 0);
+    if (!page) {
+        return 0;
+    }
 
     // read the float from the cache and return it
-    return dataCache->cache[address];
+    return page[address & (DATA_PAGE_SIZE - 1)];
 }
 
-// prints the contents of the data cache to the command line
+// prints the contents of the data cache to the command line, only pages that were written to are included
 void printDataCache(DataCache *dataCache) {
 
     printf("data cache: \n");
@@ -98,23 +166,133 @@ void printDataCache(DataCache *dataCache) {
     }
     printf("\n");
 
-    // print each full row of bytes
-    for (int i = 0; i < dataCache->cacheSize / entriesPerRow; i++) {
-        printf("%7d | ", i * entriesPerRow);
-        for (int j = 0; j < entriesPerRow; j++) {
-            printf("%7.1f", readFloatFromDataCache(dataCache, i * entriesPerRow + j));
+    // print each row of every allocated page in address order
+    for (int i = 0; i < DATA_PAGE_DIRECTORY_SIZE; i++) {
+        float **pageTable = dataCache->pageDirectory[i];
+        if (!pageTable) {
+            continue;
+        }
+
+        for (int j = 0; j < DATA_PAGE_TABLE_SIZE; j++) {
+            float *page = pageTable[j];
+            if (!page) {
+                continue;
+            }
+
+            int pageAddress = ((i << DATA_PAGE_TABLE_BITS) + j) << DATA_PAGE_BITS;
+
+            for (int row = 0; row < DATA_PAGE_SIZE / entriesPerRow; row++) {
+                printf("%7d | ", pageAddress + row * entriesPerRow);
+                for (int k = 0; k < entriesPerRow; k++) {
+                    printf("%7.1f", page[row * entriesPerRow + k]);
+                }
+                printf("\n");
+            }
         }
-        printf("\n");
     }
+}
+
+// models an access to the given address in the L1 data cache starting in a given cycle, going to the levels below on a
+// miss, and returns the number of cycles it takes
+int accessL1DataCache(DataCache *dataCache, int address, int cycle, int isLoad) {
 
-    // print the remaining row if the cache cannot be divided evenly
-    if (dataCache->cacheSize % entriesPerRow != 0) {
-        int lastRow = dataCache->cacheSize / entriesPerRow;
+    int hit = cacheModelContainsAddress(dataCache->l1Cache, address, CACHE_ADDR_SPACE_DATA);
+    int latency = accessCacheModel(dataCache->l1Cache, address, CACHE_ADDR_SPACE_DATA);
+
+    // a line that was prefetched only has to be moved from the prefetch buffer, waiting for it if it has not arrived yet
+    if (!hit) {
+        int prefetchCycles = -1;
+        if (dataCache->prefetcher) {
+            prefetchCycles = takeLineFromPrefetchBuffer(dataCache->prefetcher, cacheModelLineAddress(dataCache->l1Cache, address), cycle + latency);
+        }
 
-        printf("%7d", lastRow * entriesPerRow);
-        for (int j = 0; j < dataCache->cacheSize % entriesPerRow; j++) {
-            printf("%7.1f", readFloatFromDataCache(dataCache, lastRow * entriesPerRow + j));
+        if (prefetchCycles != -1) {
+            latency += prefetchCycles;
+        } else {
+            latency += accessDataCacheBelowL1(dataCache, address, CACHE_ADDR_SPACE_DATA, cycle + latency, isLoad);
         }
-        printf("\n");
     }
-}
\ No newline at end of file
+
+    if (isLoad) {
+        recordCacheModelLoad(dataCache->l1Cache, latency);
+    }
+
+    return latency;
+}
+
+// models a line fill for an L1 miss to an address of an address space arriving at the L2 cache in a given cycle and returns
+// the number of cycles until the line returns, 0 if neither an L2 cache nor memory latency is modeled
+int accessDataCacheBelowL1(DataCache *dataCache, int address, int addressSpace, int cycle, int isLoad) {
+
+    int latency = 0;
+    int missedInL2 = 1;
+
+    if (dataCache->l2Cache) {
+        missedInL2 = !cacheModelContainsAddress(dataCache->l2Cache, address, addressSpace);
+        latency = accessCacheModel(dataCache->l2Cache, address, addressSpace);
+    }
+
+    if (missedInL2 && dataCache->dram) {
+        latency += accessDRAMModel(dataCache->dram, cycle + latency, isLoad);
+    }
+
+    if (isLoad && dataCache->l2Cache) {
+        recordCacheModelLoad(dataCache->l2Cache, latency);
+    }
+
+    return latency;
+}
+
+// returns 1 if a load that misses in the L1 data cache takes more than a single cycle, so it has to wait for its line
+// in a MSHR
+int dataCacheMissTakesMultipleCycles(DataCache *dataCache) {
+    return dataCache->l1Cache->missLatency > 1 || dataCache->l2Cache || dataCache->dram;
+}
+
+// trains the prefetcher with the address read by the load at a given pc, and if the load is confident in its stride
+// prefetches the lines it is expected to read next that are neither in the L1 cache nor already prefetched
+void prefetchForDataCacheLoad(DataCache *dataCache, int pc, int address, int cycle) {
+
+    StridePrefetcher *prefetcher = dataCache->prefetcher;
+    if (!prefetcher) {
+        return;
+    }
+
+    int stride = trainStridePrefetcher(prefetcher, pc, address);
+    if (stride == 0) {
+        return;
+    }
+
+    for (int i = 0; i < prefetcher->degree; i++) {
+        long long target = (long long) address + (long long) stride * (prefetcher->distance + i);
+        if (target < 0 || target > INT_MAX) {
+            break;
+        }
+
+        int lineAddr = cacheModelLineAddress(dataCache->l1Cache, (int) target);
+        if (cacheModelContainsAddress(dataCache->l1Cache, (int) target, CACHE_ADDR_SPACE_DATA) || prefetchBufferContainsLine(prefetcher, lineAddr)) {
+            continue;
+        }
+
+        // prefetches compete with misses for the L2 cache and memory bandwidth
+        int readyCycle = cycle + accessDataCacheBelowL1(dataCache, (int) target, CACHE_ADDR_SPACE_DATA, cycle, 0);
+        addLineToPrefetchBuffer(prefetcher, lineAddr, readyCycle);
+    }
+}
+
+// prints the statistics of the modeled data caches and memory
+void printDataCacheStats(DataCache *dataCache) {
+    printCacheModelStats(dataCache->l1Cache);
+
+    if (dataCache->prefetcher) {
+        printStridePrefetcherStats(dataCache->prefetcher);
+    }
+
+    if (dataCache->l2Cache) {
+        printCacheModelStats(dataCache->l2Cache);
+    }
+
+    if (dataCache->dram) {
+        printDRAMModelStats(dataCache->dram);
+    }
+}
@@ -1,16 +1,37 @@
 
-#define DATA_CACHE_INITIAL_SIZE 256 // initial number of bytes to allocate for the data cache (can be reallocated later if needed)
+// forward declarations
+typedef struct Params Params;
+typedef struct CacheModel CacheModel;
+typedef struct DRAMModel DRAMModel;
+typedef struct StridePrefetcher StridePrefetcher;
+
+// the backing memory is split into pages that are only allocated once they are written to, found through a two level
+// page table indexed by the upper and lower bits of the page number
+#define DATA_PAGE_BITS 10 // each page holds 1024 addresses, 4 KiB of floats
+#define DATA_PAGE_SIZE (1 << DATA_PAGE_BITS)
+#define DATA_PAGE_TABLE_BITS 10 // number of bits of the page number used to index a second level table
+#define DATA_PAGE_TABLE_SIZE (1 << DATA_PAGE_TABLE_BITS)
+#define DATA_PAGE_DIRECTORY_SIZE (1 << (31 - DATA_PAGE_BITS - DATA_PAGE_TABLE_BITS)) // enough to cover every non-negative int address
 
 // struct representing a data cache
 typedef struct DataCache {
-    int cacheSize;
-    float *cache;
+    float ***pageDirectory; // pageDirectory[directory index][table index] is a page, NULL until it is first written
+    int numPages;
+    CacheModel *l1Cache; // timing model of the L1 data cache, values are always read from and written to the array above
+    CacheModel *l2Cache; // timing model of the unified L2 cache behind it, NULL if there is none
+    DRAMModel *dram; // timing model of the memory behind the last cache level, NULL if memory is ideal
+    StridePrefetcher *prefetcher; // fetches lines for loads with a regular stride ahead of them, NULL if there is none
 } DataCache;
 
 // data cache methods
-void initDataCache(DataCache *dataCache);
+void initDataCache(DataCache *dataCache, Params *params);
 void teardownDataCache(DataCache *dataCache);
-void extendDataCacheIfNeeded(DataCache *dataCache, int address);
+float *dataCachePageForAddress(DataCache *dataCache, int address, int allocate);
 void writeFloatToDataCache(DataCache *dataCache, int address, float value);
 float readFloatFromDataCache(DataCache *dataCache, int address);
 void printDataCache(DataCache *dataCache);
+int accessL1DataCache(DataCache *dataCache, int address, int cycle, int isLoad);
+int accessDataCacheBelowL1(DataCache *dataCache, int address, int addressSpace, int cycle, int isLoad); // addressSpace = enum CacheAddressSpace
+int dataCacheMissTakesMultipleCycles(DataCache *dataCache);
+void prefetchForDataCacheLoad(DataCache *dataCache, int pc, int address, int cycle);
+void printDataCacheStats(DataCache *dataCache);
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../misc/misc.h"
+#include "dram_model.h"
+
+// initialize a struct representing the timing model of the memory
+void initDRAMModel(DRAMModel *dram, int latency, int requestsPerCycle) {
+
+    if (requestsPerCycle < 1) {
+        printf("error: memory needs to take at least 1 request per cycle, got %i\n", requestsPerCycle);
+        exitSimulation(1);
+    }
+
+    dram->latency = latency;
+    dram->requestsPerCycle = requestsPerCycle;
+
+    dram->slotCycle = -1;
+    dram->numSlotRequests = 0;
+
+    dram->numRequests = 0;
+    dram->numLoads = 0;
+    dram->totalQueueCycles = 0;
+    dram->totalLoadCycles = 0;
+}
+
+// schedules a request arriving in a given cycle and returns the number of cycles until its data returns
+int accessDRAMModel(DRAMModel *dram, int cycle, int isLoad) {
+
+    // start a new slot once every request of the previous ones has started, otherwise wait for the next one with room
+    if (cycle > dram->slotCycle) {
+        dram->slotCycle = cycle;
+        dram->numSlotRequests = 0;
+    } else if (dram->numSlotRequests == dram->requestsPerCycle) {
+        dram->slotCycle++;
+        dram->numSlotRequests = 0;
+    }
+
+    dram->numSlotRequests++;
+
+    int queueCycles = dram->slotCycle - cycle;
+    int latency = queueCycles + dram->latency;
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("memory request arriving in cycle: %i starts in cycle: %i, latency: %i\n", cycle, dram->slotCycle, latency);
+    #endif
+
+    dram->numRequests++;
+    dram->totalQueueCycles += queueCycles;
+    if (isLoad) {
+        dram->numLoads++;
+        dram->totalLoadCycles += latency;
+    }
+
+    return latency;
+}
+
+// prints the request counters of the memory model
+void printDRAMModelStats(DRAMModel *dram) {
+    printf("\nmemory statistics:\n");
+    printf("\trequests: %i\n", dram->numRequests);
+    printf("\taverage cycles waiting for bandwidth: %.2f\n", dram->numRequests ? (double) dram->totalQueueCycles / dram->numRequests : 0.0);
+    printf("\taverage load latency: %.2f\n", dram->numLoads ? (double) dram->totalLoadCycles / dram->numLoads : 0.0);
+}
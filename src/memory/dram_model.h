@@ -0,0 +1,20 @@
+
+// struct representing the timing model of the memory behind the last cache level, every request takes a fixed latency
+// and at most a given number of requests can start in a cycle, later ones queue behind them in the order they arrive
+typedef struct DRAMModel {
+    int latency;
+    int requestsPerCycle;
+
+    int slotCycle; // latest cycle in which a request was scheduled to start
+    int numSlotRequests; // requests scheduled to start in slotCycle
+
+    int numRequests;
+    int numLoads;
+    long long totalQueueCycles; // cycles requests spent waiting for bandwidth
+    long long totalLoadCycles; // cycles from a load's request arriving until its data returns
+} DRAMModel;
+
+// DRAM model methods
+void initDRAMModel(DRAMModel *dram, int latency, int requestsPerCycle);
+int accessDRAMModel(DRAMModel *dram, int cycle, int isLoad);
+void printDRAMModelStats(DRAMModel *dram);
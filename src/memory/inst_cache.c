@@ -2,23 +2,48 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cache_model.h"
+#include "data_cache.h"
 #include "inst_cache.h"
 #include "../misc/misc.h"
 
 // initialize a struct representing the instruction cache
-void initInstCache(InstCache *instCache) {
+void initInstCache(InstCache *instCache, Params *params) {
     printf_DEBUG(("initalizing instruction cache...\n"));
     
     instCache->numInsts = 0;
     instCache->cacheSize = INST_CACHE_INITIAL_SIZE;
     instCache->cache = calloc(INST_CACHE_INITIAL_SIZE, sizeof(char *));
+    instCache->decodedInsts = NULL;
+
+    // a line that hits can be fetched from in the same cycle
+    instCache->l1Cache = malloc(sizeof(CacheModel));
+    initCacheModel(instCache->l1Cache, "L1 instruction cache", params->l1iSets, params->l1iWays, params->l1iLineSize, CACHE_REPL_LRU, 1, 
+        params->l1iMissLatency);
 }
 
 // free any elements of the instruction cache stored on the heap
 void teardownInstCache(InstCache *instCache) {
     if (instCache->cache) {
+        for (int i = 0; i < instCache->numInsts; i++) {
+            free(instCache->cache[i]);
+        }
         free(instCache->cache);
     }
+
+    if (instCache->decodedInsts) {
+        for (int i = 0; i < instCache->numInsts; i++) {
+            DecodedInstruction *decodedInst = &instCache->decodedInsts[i];
+            free(decodedInst->branchTargetLabel);
+            free(decodedInst->label);
+        }
+        free(instCache->decodedInsts);
+    }
+
+    if (instCache->l1Cache) {
+        teardownCacheModel(instCache->l1Cache);
+        free(instCache->l1Cache);
+    }
 }
 
 // doubles the size of the instruction cache
@@ -44,8 +69,8 @@ void extendInstCacheIfNeeded(InstCache *instCache) {
     }
 }
 
-// returns an instruction in the instruction cache at the given address
-char *readInstructionCache(InstCache *instCache, int address) {
+// returns the decoded instruction in the instruction cache at the given address
+DecodedInstruction *readInstructionCache(InstCache *instCache, int address) {
     int index = address / 4; // since there are 4 bytes per instruction being simulated
 
     if (index < 0 || index >= instCache->numInsts) {
@@ -56,7 +81,7 @@ char *readInstructionCache(InstCache *instCache, int address) {
         return NULL;
     }
 
-    return instCache->cache[index];
+    return &instCache->decodedInsts[index];
 }
 
 // adds a new instruction to the instruction cache when processing the input file
@@ -73,4 +98,263 @@ void addInstructionToCache(InstCache *instCache, char *instStr) {
     #ifdef ENABLE_DEBUG_LOG
     printf("added instruction: '%s' to cache\n", instStr);
     #endif
-}
\ No newline at end of file
+}
+
+// helper method to copy a token into a newly allocated string
+static char *copyToken(char *token, int len) {
+    char *str = malloc((len + 1) * sizeof(char));
+    memcpy(str, token, len);
+    str[len] = '\0';
+
+    return str;
+}
+
+// parses an instruction string into a decoded instruction. returns 1 if decoding was successful, 0 if not
+int decodeInstruction(DecodedInstruction *decodedInst, LabelTable *labelTable, char *instStr, int instAddr) {
+
+    // initialize decoded instruction
+    decodedInst->type = INST_TYPE_NONE;
+    decodedInst->destReg = NULL;
+    decodedInst->source1Reg = NULL;
+    decodedInst->source2Reg = NULL;
+    decodedInst->imm = 0;
+    decodedInst->branchTarget = -1;
+    decodedInst->branchTargetLabel = NULL;
+    decodedInst->label = NULL;
+    decodedInst->addr = instAddr;
+    decodedInst->fullStr = instStr;
+
+    // copy input string to buffer so that it does not modified by strtok_r, which keeps its position in savePtr instead of
+    // shared state so programs can be decoded on several threads at once
+    char instBuf[256];
+    char *savePtr = NULL;
+    strncpy(instBuf, instStr, sizeof(instBuf) - 1);
+    instBuf[sizeof(instBuf) - 1] = '\0';
+
+    // get the first token of the line
+    char *cur = strtok_r(instBuf, " \n\t,", &savePtr);
+
+    if (cur == NULL) {
+        printf("error: tried to decode instruction that was empty\n");
+        return 0;
+    }
+
+    // the first token containing a colon indicates it is a label
+    if (strstr(cur, ":")) {
+        decodedInst->label = copyToken(cur, strlen(cur) - 1);
+        cur = strtok_r(NULL, " \n\t,", &savePtr);
+
+        if (cur == NULL) {
+            printf("error: label '%s' is not followed by an instruction\n", decodedInst->label);
+            return 0;
+        }
+    }
+    
+    // convert the instruction type to an enum
+    decodedInst->type = stringToInstructionType(cur);
+
+    // instruction type could not be matched
+    if (decodedInst->type == INST_TYPE_NONE) {
+        
+        printf("error: invalid instruction type '%s'\n", cur);
+        return 0;
+
+    // memory access instructions
+    } else if (decodedInst->type == FLD || decodedInst->type == FSD) {
+
+        char *regStr = strtok_r(NULL, " \n\t,", &savePtr);
+        char *offsetStr = strtok_r(NULL, " \n\t,()", &savePtr);
+        char *baseStr = strtok_r(NULL, " \n\t,()", &savePtr);
+
+        if (!regStr || !offsetStr || !baseStr) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        // in reality stores use the destination field but having it be the source 1 simplified things for implementing this
+        if (decodedInst->type == FLD) {
+            decodedInst->destReg = stringToArchRegister(regStr);
+        } else {
+            decodedInst->source1Reg = stringToArchRegister(regStr);
+        }
+        decodedInst->imm = atoi(offsetStr);
+        decodedInst->source2Reg = stringToArchRegister(baseStr);
+
+        if (!(decodedInst->destReg || decodedInst->source1Reg) || !decodedInst->source2Reg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+    // register-immediate instruction
+    } else if (decodedInst->type == ADDI) {
+
+        char *destStr = strtok_r(NULL, " \n\t,", &savePtr);
+        char *source1Str = strtok_r(NULL, " \n\t,", &savePtr);
+        char *immStr = strtok_r(NULL, " \n\t,", &savePtr);
+
+        if (!destStr || !source1Str || !immStr) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->destReg = stringToArchRegister(destStr);
+        decodedInst->source1Reg = stringToArchRegister(source1Str);
+        decodedInst->imm = atoi(immStr);
+
+        if (!decodedInst->destReg || !decodedInst->source1Reg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+    // register-register instructions
+    } else if (decodedInst->type == ADD || decodedInst->type == SLT || decodedInst->type == FADD || decodedInst->type == FSUB || decodedInst->type == FMUL || decodedInst->type == FDIV) {
+        
+        char *destStr = strtok_r(NULL, " \n\t,", &savePtr);
+        char *source1Str = strtok_r(NULL, " \n\t,", &savePtr);
+        char *source2Str = strtok_r(NULL, " \n\t,", &savePtr);
+
+        if (!destStr || !source1Str || !source2Str) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->destReg = stringToArchRegister(destStr);
+        decodedInst->source1Reg = stringToArchRegister(source1Str);
+        decodedInst->source2Reg = stringToArchRegister(source2Str);
+
+        if (!decodedInst->destReg || !decodedInst->source1Reg || !decodedInst->source2Reg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+    // branch instruction
+    } else if (decodedInst->type == BNE) {
+
+        char *source1Str = strtok_r(NULL, " \n\t,", &savePtr);
+        char *source2Str = strtok_r(NULL, " \n\t,", &savePtr);
+        char *targetLabel = strtok_r(NULL, " \n\t,", &savePtr);
+
+        if (!source1Str || !source2Str || !targetLabel) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->source1Reg = stringToArchRegister(source1Str);
+        decodedInst->source2Reg = stringToArchRegister(source2Str);
+        decodedInst->branchTargetLabel = copyToken(targetLabel, strlen(targetLabel));
+
+        if (!decodedInst->source1Reg || !decodedInst->source2Reg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        // resolve the target address once here instead of every time the branch is fetched
+        decodedInst->branchTarget = getAddressForLabel(labelTable, decodedInst->branchTargetLabel);
+        if (decodedInst->branchTarget == -1) {
+            printf("error: invalid target label in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        // branch instructions store the pc offset to the target instruction in the imm field (in real implementations this is encoded in instruction already)
+        decodedInst->imm = decodedInst->branchTarget - decodedInst->addr;
+
+    // jump and link instruction
+    } else if (decodedInst->type == JAL) {
+
+        char *destStr = strtok_r(NULL, " \n\t,", &savePtr);
+        char *targetLabel = strtok_r(NULL, " \n\t,", &savePtr);
+
+        if (!destStr || !targetLabel) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->destReg = stringToArchRegister(destStr);
+        decodedInst->branchTargetLabel = copyToken(targetLabel, strlen(targetLabel));
+
+        if (!decodedInst->destReg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->branchTarget = getAddressForLabel(labelTable, decodedInst->branchTargetLabel);
+        if (decodedInst->branchTarget == -1) {
+            printf("error: invalid target label in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->imm = decodedInst->branchTarget - decodedInst->addr;
+
+    // jump and link register instruction, written like a load as the target is an offset from a register
+    } else if (decodedInst->type == JALR) {
+
+        char *destStr = strtok_r(NULL, " \n\t,", &savePtr);
+        char *offsetStr = strtok_r(NULL, " \n\t,()", &savePtr);
+        char *baseStr = strtok_r(NULL, " \n\t,()", &savePtr);
+
+        if (!destStr || !offsetStr || !baseStr) {
+            printf("error: missing operand in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+        decodedInst->destReg = stringToArchRegister(destStr);
+        decodedInst->imm = atoi(offsetStr);
+        decodedInst->source1Reg = stringToArchRegister(baseStr);
+
+        if (!decodedInst->destReg || !decodedInst->source1Reg) {
+            printf("error: invalid register in instruction: '%s'\n", instStr);
+            return 0;
+        }
+
+    } else {
+        printf("error: could not match this point should never be reached...\n");
+        return 0;
+    }
+
+    // jumps that discard their return address by writing it to $0 do not need a destination register
+    if ((decodedInst->type == JAL || decodedInst->type == JALR) && decodedInst->destReg->regType == ARCH_REG_ZERO) {
+        decodedInst->destReg = NULL;
+    }
+
+    return 1;
+}
+
+// decodes every instruction in the cache once so that the fetch and decode units never need to parse strings. returns 1 if successful, 0 if not
+int decodeInstCache(InstCache *instCache, LabelTable *labelTable) {
+
+    printf_DEBUG(("decoding instruction cache...\n"));
+
+    instCache->decodedInsts = calloc(instCache->numInsts, sizeof(DecodedInstruction));
+
+    // labels can be used before they are defined, so decoding is done after every instruction is in the cache
+    for (int i = 0; i < instCache->numInsts; i++) {
+        if (!decodeInstruction(&instCache->decodedInsts[i], labelTable, instCache->cache[i], i * 4)) {
+            return 0;
+        }
+
+        #ifdef ENABLE_DEBUG_LOG
+        printf("decoded instruction: '%s' type: %i imm: %i\n", instCache->cache[i], instCache->decodedInsts[i].type, instCache->decodedInsts[i].imm);
+        #endif
+    }
+
+    return 1;
+}
+
+// models fetching the line holding a given instruction address from the L1 instruction cache starting in a given cycle,
+// going to the unified L2 cache and memory on a miss, and returns the number of cycles until it can be fetched from
+int accessL1InstCache(InstCache *instCache, DataCache *dataCache, int address, int cycle) {
+
+    int hit = cacheModelContainsAddress(instCache->l1Cache, address, CACHE_ADDR_SPACE_INST);
+    int latency = accessCacheModel(instCache->l1Cache, address, CACHE_ADDR_SPACE_INST);
+
+    if (!hit) {
+        latency += accessDataCacheBelowL1(dataCache, address, CACHE_ADDR_SPACE_INST, cycle + latency, 0);
+    }
+
+    return latency;
+}
+
+// prints the statistics of the modeled instruction cache
+void printInstCacheStats(InstCache *instCache) {
+    printCacheModelStats(instCache->l1Cache);
+}
@@ -1,18 +1,30 @@
 
 #define INST_CACHE_INITIAL_SIZE 256 // initial number of instructions to store in the instruction cache
 
-typedef struct Instruction Instruction; // forward declaration
+// forward declarations
+typedef struct Instruction Instruction;
+typedef struct DecodedInstruction DecodedInstruction;
+typedef struct LabelTable LabelTable;
+typedef struct Params Params;
+typedef struct CacheModel CacheModel;
+typedef struct DataCache DataCache;
 
 // struct representing an instruction cache
 typedef struct InstCache {
     char **cache;
+    DecodedInstruction *decodedInsts; // filled once by decodeInstCache after the program is loaded
     int cacheSize;
     int numInsts;
+    CacheModel *l1Cache; // timing model of the L1 instruction cache, instructions are always read from the arrays above
 } InstCache;
 
 // instruction cache methods
-void initInstCache(InstCache *instCache);
+void initInstCache(InstCache *instCache, Params *params);
 void teardownInstCache(InstCache *instCache);
 void extendInstCacheIfNeeded(InstCache *instCache);
-char *readInstructionCache(InstCache *instCache, int address);
-void addInstructionToCache(InstCache *instCache, char *instStr);
\ No newline at end of file
+DecodedInstruction *readInstructionCache(InstCache *instCache, int address);
+void addInstructionToCache(InstCache *instCache, char *instStr);
+int decodeInstruction(DecodedInstruction *decodedInst, LabelTable *labelTable, char *instStr, int instAddr);
+int decodeInstCache(InstCache *instCache, LabelTable *labelTable);
+int accessL1InstCache(InstCache *instCache, DataCache *dataCache, int address, int cycle);
+void printInstCacheStats(InstCache *instCache);
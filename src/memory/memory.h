@@ -1,4 +1,7 @@
 
 #include "inst_cache.h"
+#include "cache_model.h"
+#include "dram_model.h"
+#include "stride_prefetcher.h"
 #include "data_cache.h"
 #include "register_file.h"
@@ -7,18 +7,16 @@
 #include "register_file.h"
 
 // initialize the register file struct
-void initRegisterFile(RegisterFile *registerFile) {
+void initRegisterFile(RegisterFile *registerFile, int numPhysicalRegisters) {
 
     registerFile->pc = 0;
-    registerFile->numPhysicalRegisters = PHYS_REG_SIZE;
-    registerFile->physicalRegisters = malloc(registerFile->numPhysicalRegisters * sizeof(RegisterFileEntry *));
+    registerFile->numPhysicalRegisters = numPhysicalRegisters;
+    registerFile->physicalRegisters = malloc(registerFile->numPhysicalRegisters * sizeof(RegisterFileEntry));
     for (int i = 0; i < registerFile->numPhysicalRegisters; i++) {
-        RegisterFileEntry *entry = malloc(sizeof(RegisterFileEntry));
+        RegisterFileEntry *entry = &registerFile->physicalRegisters[i];
         entry->floatVal = 0;
         entry->intVal = 0;
         entry->valueType = VALUE_TYPE_NONE;
-
-        registerFile->physicalRegisters[i] = entry;   
     }
 }
 
@@ -26,9 +24,6 @@ void initRegisterFile(RegisterFile *registerFile) {
 void teardownRegisterFile(RegisterFile *registerFile) {
     
     if (registerFile->physicalRegisters) {
-        for (int i = 0; i < registerFile->numPhysicalRegisters; i++) {
-            free(registerFile->physicalRegisters[i]);
-        }
         free(registerFile->physicalRegisters);
     }
 }
@@ -45,15 +40,16 @@ int readRegisterFileInt(RegisterFile *registerFile, enum PhysicalRegisterName re
     // error if invalid register
     } else if (reg < 0 || reg >= registerFile->numPhysicalRegisters) {
         printf("error: tried to read integer register: %i which is not in the register file\n", reg);
-        exit(1);
+        exitSimulation(1);
     }
 
     // return the value of the register
-    RegisterFileEntry *entry = registerFile->physicalRegisters[reg];
+    RegisterFileEntry *entry = &registerFile->physicalRegisters[reg];
     entry->valueType = VALUE_TYPE_INT;
 
     #ifdef ENABLE_DEBUG_LOG
-    printf("read register: %s, int: %i\n", physicalRegisterNameToString(reg), entry->intVal);
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("read register: %s, int: %i\n", physicalRegisterNameToString(reg, regName), entry->intVal);
     #endif
 
     return entry->intVal;
@@ -68,15 +64,16 @@ float readRegisterFileFloat(RegisterFile *registerFile, enum PhysicalRegisterNam
     // error if invalid register
     } else if (reg < 0 || reg >= registerFile->numPhysicalRegisters) {
         printf("error: tried to read float register: %i which is not in the register file\n", reg);
-        exit(1);
+        exitSimulation(1);
     }
 
     // return the value of the register
-    RegisterFileEntry *entry = registerFile->physicalRegisters[reg];
+    RegisterFileEntry *entry = &registerFile->physicalRegisters[reg];
     entry->valueType = VALUE_TYPE_FLOAT;
     
     #ifdef ENABLE_DEBUG_LOG
-    printf("read register: %s, float: %f\n", physicalRegisterNameToString(reg), entry->floatVal);
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("read register: %s, float: %f\n", physicalRegisterNameToString(reg, regName), entry->floatVal);
     #endif
 
     return entry->floatVal;
@@ -92,19 +89,20 @@ void writeRegisterFileInt(RegisterFile *registerFile, enum PhysicalRegisterName
     // check if attempting to write to the $0 register
     } else if (reg == PHYS_REG_ZERO) {
         printf("error: attempted to write to register $0 which cannot be done\n");
-        exit(1);
+        exitSimulation(1);
     // error if invalid register
     } else if (reg < 0 || reg >= registerFile->numPhysicalRegisters) {
         printf("error: tried to write integer to register: %i which is not in the register file\n", reg);
-        exit(1);
+        exitSimulation(1);
     }
 
     #ifdef ENABLE_DEBUG_LOG
-    printf("\nwriting int: %i to register: %s\n", value, physicalRegisterNameToString(reg));
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("\nwriting int: %i to register: %s\n", value, physicalRegisterNameToString(reg, regName));
     #endif
 
     // write the value to the register
-    RegisterFileEntry *entry = registerFile->physicalRegisters[reg];
+    RegisterFileEntry *entry = &registerFile->physicalRegisters[reg];
     entry->intVal = value;
     entry->valueType = VALUE_TYPE_INT;
 } 
@@ -115,23 +113,24 @@ void writeRegisterFileFloat(RegisterFile *registerFile, enum PhysicalRegisterNam
     // check if writing to PC
     if (reg == PHYS_REG_PC) {
         printf("error: attempted to write a float to register PC which cannot be done\n");
-        exit(1);
+        exitSimulation(1);
     // check if attempting to write to the $0 register
     } else if (reg == PHYS_REG_ZERO) {
         printf("error: attempted to write to register $0 which cannot be done\n");
-        exit(1);
+        exitSimulation(1);
     // error if invalid register
     } else if (reg < 0 || reg >= registerFile->numPhysicalRegisters) {
         printf("error: tried to write float register: %i which is not in the register file\n", reg);
-        exit(1);
+        exitSimulation(1);
     }
 
     #ifdef ENABLE_DEBUG_LOG
-    printf("\nwriting float: %f to register: %s\n", value, physicalRegisterNameToString(reg));
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("\nwriting float: %f to register: %s\n", value, physicalRegisterNameToString(reg, regName));
     #endif
 
     // write the value to the register
-    RegisterFileEntry *entry = registerFile->physicalRegisters[reg];
+    RegisterFileEntry *entry = &registerFile->physicalRegisters[reg];
     entry->floatVal = value;
     entry->valueType = VALUE_TYPE_FLOAT;
 } 
@@ -139,20 +138,22 @@ void writeRegisterFileFloat(RegisterFile *registerFile, enum PhysicalRegisterNam
 // print the contents of the register file
 void printRegisterFile(RegisterFile *registerFile) {
 
+    char regName[PHYS_REG_NAME_SIZE];
+
     printf("register file:\n");
 
     printf("\tPC: %i\n", readRegisterFileInt(registerFile, PHYS_REG_PC));
 
     // loop over every physical register 
     for (int i = 0; i < registerFile->numPhysicalRegisters; i++) {
-        RegisterFileEntry *entry = registerFile->physicalRegisters[i];
+        RegisterFileEntry *entry = &registerFile->physicalRegisters[i];
 
         if (entry->valueType == VALUE_TYPE_INT) {
-            printf("\t%s: %i\n", physicalRegisterNameToString(i), entry->intVal);
+            printf("\t%s: %i\n", physicalRegisterNameToString(i, regName), entry->intVal);
         } else if (entry->valueType == VALUE_TYPE_FLOAT) {
-            printf("\t%s: %.1f\n", physicalRegisterNameToString(i), entry->floatVal);
+            printf("\t%s: %.1f\n", physicalRegisterNameToString(i, regName), entry->floatVal);
         } else {
-            printf("\t%s: 0 (never used)\n", physicalRegisterNameToString(i));
+            printf("\t%s: 0 (never used)\n", physicalRegisterNameToString(i, regName));
         }
     }
 }
\ No newline at end of file
@@ -8,13 +8,13 @@ typedef struct RegisterFileEntry {
 
 // struct representing the register file
 typedef struct RegisterFile {
-    RegisterFileEntry **physicalRegisters;
+    RegisterFileEntry *physicalRegisters;
     int numPhysicalRegisters;
     int pc;
 } RegisterFile;
 
 // register file methods
-void initRegisterFile(RegisterFile *registerFile);
+void initRegisterFile(RegisterFile *registerFile, int numPhysicalRegisters);
 void teardownRegisterFile(RegisterFile *registerFile);
 void printRegisterFile(RegisterFile *registerFile);
 int readRegisterFileInt(RegisterFile *registerFile, int reg); // reg = enum IntRegisterName
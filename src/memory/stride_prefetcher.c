@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../misc/misc.h"
+#include "stride_prefetcher.h"
+
+// initialize a struct representing a stride prefetcher
+void initStridePrefetcher(StridePrefetcher *prefetcher, int tableSize, int bufferSize, int degree, int distance) {
+    #ifdef ENABLE_DEBUG_LOG
+    printf("initalizing stride prefetcher: table size: %i, buffer size: %i, degree: %i, distance: %i\n", tableSize, bufferSize, degree, distance);
+    #endif
+
+    prefetcher->table = calloc(tableSize, sizeof(StridePrefetchEntry));
+    prefetcher->tableSize = tableSize;
+
+    prefetcher->buffer = calloc(bufferSize, sizeof(PrefetchBufferEntry));
+    prefetcher->bufferSize = bufferSize;
+    prefetcher->bufferNext = 0;
+
+    prefetcher->degree = degree;
+    prefetcher->distance = distance;
+
+    prefetcher->numIssued = 0;
+    prefetcher->numUseful = 0;
+    prefetcher->numLate = 0;
+    prefetcher->numUnused = 0;
+    prefetcher->numUncoveredMisses = 0;
+}
+
+// free any elements of the stride prefetcher stored on the heap
+void teardownStridePrefetcher(StridePrefetcher *prefetcher) {
+    if (prefetcher->table) {
+        free(prefetcher->table);
+    }
+
+    if (prefetcher->buffer) {
+        free(prefetcher->buffer);
+    }
+}
+
+// updates the table entry of a load with the address it read, and returns the stride to prefetch with if the load is
+// confident in it or 0 otherwise
+int trainStridePrefetcher(StridePrefetcher *prefetcher, int pc, int address) {
+
+    StridePrefetchEntry *entry = &prefetcher->table[(pc / 4) % prefetcher->tableSize];
+
+    // a load seen for the first time replaces whichever load used the entry before
+    if (!entry->valid || entry->pc != pc) {
+        entry->valid = 1;
+        entry->pc = pc;
+        entry->lastAddr = address;
+        entry->stride = 0;
+        entry->confidence = 0;
+        return 0;
+    }
+
+    int stride = address - entry->lastAddr;
+    entry->lastAddr = address;
+
+    // a different stride only replaces the old one once the old one has lost its confidence
+    if (stride == entry->stride) {
+        if (entry->confidence < STRIDE_PREFETCH_MAX_CONFIDENCE) {
+            entry->confidence++;
+        }
+    } else if (entry->confidence > 0) {
+        entry->confidence--;
+    } else {
+        entry->stride = stride;
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("stride prefetcher trained load at: %i with address: %i, stride: %i, confidence: %i\n", pc, address, entry->stride, entry->confidence);
+    #endif
+
+    if (entry->confidence < STRIDE_PREFETCH_CONFIDENCE_THRESHOLD) {
+        return 0;
+    }
+
+    return entry->stride;
+}
+
+// returns the index of the prefetch buffer entry holding a given line, -1 if it is not in the buffer
+int prefetchBufferIndexForLine(StridePrefetcher *prefetcher, int lineAddr) {
+    for (int i = 0; i < prefetcher->bufferSize; i++) {
+        if (prefetcher->buffer[i].valid && prefetcher->buffer[i].lineAddr == lineAddr) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// returns 1 if a given line was prefetched and not taken yet
+int prefetchBufferContainsLine(StridePrefetcher *prefetcher, int lineAddr) {
+    return prefetchBufferIndexForLine(prefetcher, lineAddr) != -1;
+}
+
+// places a prefetched line in the buffer, replacing the oldest one
+void addLineToPrefetchBuffer(StridePrefetcher *prefetcher, int lineAddr, int readyCycle) {
+
+    PrefetchBufferEntry *entry = &prefetcher->buffer[prefetcher->bufferNext];
+    prefetcher->bufferNext = (prefetcher->bufferNext + 1) % prefetcher->bufferSize;
+
+    if (entry->valid) {
+        prefetcher->numUnused++;
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("prefetching line: %i, arriving in cycle: %i\n", lineAddr, readyCycle);
+    #endif
+
+    entry->valid = 1;
+    entry->lineAddr = lineAddr;
+    entry->readyCycle = readyCycle;
+
+    prefetcher->numIssued++;
+}
+
+// looks for the line of an L1 miss in a given cycle in the buffer, removing it since it moves into the L1 cache, and
+// returns the number of cycles until it arrives or -1 if it was not prefetched
+int takeLineFromPrefetchBuffer(StridePrefetcher *prefetcher, int lineAddr, int cycle) {
+
+    int index = prefetchBufferIndexForLine(prefetcher, lineAddr);
+    if (index == -1) {
+        prefetcher->numUncoveredMisses++;
+        return -1;
+    }
+
+    PrefetchBufferEntry *entry = &prefetcher->buffer[index];
+    entry->valid = 0;
+    prefetcher->numUseful++;
+
+    if (entry->readyCycle <= cycle) {
+        return 0;
+    }
+
+    prefetcher->numLate++;
+    return entry->readyCycle - cycle;
+}
+
+// prints the accuracy and coverage counters of the stride prefetcher
+void printStridePrefetcherStats(StridePrefetcher *prefetcher) {
+
+    int numMisses = prefetcher->numUseful + prefetcher->numUncoveredMisses;
+
+    printf("\nstride prefetcher statistics:\n");
+    printf("\tprefetches issued: %i\n", prefetcher->numIssued);
+    printf("\tuseful prefetches: %i\n", prefetcher->numUseful);
+    printf("\tlate prefetches: %i\n", prefetcher->numLate);
+    printf("\tunused prefetches replaced: %i\n", prefetcher->numUnused);
+    printf("\taccuracy: %.2f%%\n", prefetcher->numIssued ? 100.0 * prefetcher->numUseful / prefetcher->numIssued : 0.0);
+    printf("\tcoverage of L1 misses: %.2f%%\n", numMisses ? 100.0 * prefetcher->numUseful / numMisses : 0.0);
+}
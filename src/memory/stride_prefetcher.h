@@ -0,0 +1,49 @@
+
+// number of times in a row a load has to repeat its stride before it is prefetched for
+#define STRIDE_PREFETCH_CONFIDENCE_THRESHOLD 2
+#define STRIDE_PREFETCH_MAX_CONFIDENCE 3
+
+// struct representing an entry of the reference prediction table, which follows the addresses of a single load
+typedef struct StridePrefetchEntry {
+    int valid;
+    int pc; // address of the load instruction
+    int lastAddr; // address the load read the last time it was seen
+    int stride; // difference between the last two addresses
+    int confidence; // saturating counter of how often the stride repeated
+} StridePrefetchEntry;
+
+// struct representing a line held in the prefetch buffer until a load that misses in the L1 data cache takes it
+typedef struct PrefetchBufferEntry {
+    int valid;
+    int lineAddr; // in units of L1 data cache lines
+    int readyCycle; // cycle in which the line arrives from the L2 cache or memory
+} PrefetchBufferEntry;
+
+// struct representing a stride prefetcher, loads are tracked in a direct mapped table indexed by their address and once
+// one repeats its stride the lines it is expected to read next are fetched into a small fully associative buffer
+typedef struct StridePrefetcher {
+    StridePrefetchEntry *table;
+    int tableSize;
+
+    PrefetchBufferEntry *buffer;
+    int bufferSize;
+    int bufferNext; // the buffer is replaced in the order lines were prefetched
+
+    int degree; // lines prefetched every time a confident load is seen
+    int distance; // strides ahead of the load the first prefetch is for
+
+    int numIssued;
+    int numUseful; // prefetched lines taken by an L1 miss
+    int numLate; // useful prefetches that had not arrived yet when they were taken
+    int numUnused; // prefetched lines replaced before any miss took them
+    int numUncoveredMisses; // L1 misses whose line was not in the buffer
+} StridePrefetcher;
+
+// stride prefetcher methods
+void initStridePrefetcher(StridePrefetcher *prefetcher, int tableSize, int bufferSize, int degree, int distance);
+void teardownStridePrefetcher(StridePrefetcher *prefetcher);
+int trainStridePrefetcher(StridePrefetcher *prefetcher, int pc, int address);
+int prefetchBufferContainsLine(StridePrefetcher *prefetcher, int lineAddr);
+void addLineToPrefetchBuffer(StridePrefetcher *prefetcher, int lineAddr, int readyCycle);
+int takeLineFromPrefetchBuffer(StridePrefetcher *prefetcher, int lineAddr, int cycle);
+void printStridePrefetcherStats(StridePrefetcher *prefetcher);
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../misc/misc.h"
+#include "store_set_predictor.h"
+
+// initialize a store set predictor struct, no instruction belongs to a store set yet
+void initStoreSetPredictor(StoreSetPredictor *storeSets, int numSSITEntries, int numStoreSets) {
+
+    storeSets->numSSITEntries = numSSITEntries;
+    storeSets->ssit = malloc(numSSITEntries * sizeof(int));
+    for (int i = 0; i < numSSITEntries; i++) {
+        storeSets->ssit[i] = -1;
+    }
+
+    storeSets->numStoreSets = numStoreSets;
+    storeSets->lfst = malloc(numStoreSets * sizeof(LFSTEntry));
+    flushLastFetchedStores(storeSets);
+}
+
+// free any elements of the store set predictor that are stored on the heap
+void teardownStoreSetPredictor(StoreSetPredictor *storeSets) {
+    if (storeSets->ssit) {
+        free(storeSets->ssit);
+    }
+    if (storeSets->lfst) {
+        free(storeSets->lfst);
+    }
+}
+
+// returns the store set id table entry used by a given instruction address
+int ssitIndexForPC(StoreSetPredictor *storeSets, int pc) {
+    return (pc / 4) % storeSets->numSSITEntries;
+}
+
+// returns the store set of a given instruction address, -1 if it has none
+int storeSetForPC(StoreSetPredictor *storeSets, int pc) {
+    return storeSets->ssit[ssitIndexForPC(storeSets, pc)];
+}
+
+// returns the last fetched store table entry of the store set of a given instruction address, NULL if it has no store set
+LFSTEntry *lastFetchedStoreForPC(StoreSetPredictor *storeSets, int pc) {
+
+    int storeSet = storeSetForPC(storeSets, pc);
+    if (storeSet == -1) {
+        return NULL;
+    }
+
+    return &storeSets->lfst[storeSet];
+}
+
+// records an issued store as the one that later loads in its store set have to wait for
+void setLastFetchedStore(StoreSetPredictor *storeSets, int pc, int storeIndex, unsigned int seqNum) {
+
+    LFSTEntry *entry = lastFetchedStoreForPC(storeSets, pc);
+    if (entry) {
+        entry->storeIndex = storeIndex;
+        entry->seqNum = seqNum;
+    }
+}
+
+// removes an executed store from the last fetched store table if no younger store of its set was issued since
+void clearLastFetchedStore(StoreSetPredictor *storeSets, int pc, int storeIndex, unsigned int seqNum) {
+
+    LFSTEntry *entry = lastFetchedStoreForPC(storeSets, pc);
+    if (entry && entry->storeIndex == storeIndex && entry->seqNum == seqNum) {
+        entry->storeIndex = -1;
+    }
+}
+
+// clears every last fetched store once the stores in flight were flushed, store set membership is kept
+void flushLastFetchedStores(StoreSetPredictor *storeSets) {
+    for (int i = 0; i < storeSets->numStoreSets; i++) {
+        storeSets->lfst[i].storeIndex = -1;
+        storeSets->lfst[i].seqNum = 0;
+    }
+}
+
+// puts a load and the store it was misordered with in the same store set. when both already have one, the smaller
+// id is kept so that sets merge gradually
+void trainStoreSetPredictor(StoreSetPredictor *storeSets, int loadPC, int storePC) {
+
+    int *loadSet = &storeSets->ssit[ssitIndexForPC(storeSets, loadPC)];
+    int *storeSet = &storeSets->ssit[ssitIndexForPC(storeSets, storePC)];
+
+    if (*loadSet == -1 && *storeSet == -1) {
+        *loadSet = ssitIndexForPC(storeSets, loadPC) % storeSets->numStoreSets;
+        *storeSet = *loadSet;
+    } else if (*loadSet == -1) {
+        *loadSet = *storeSet;
+    } else if (*storeSet == -1) {
+        *storeSet = *loadSet;
+    } else if (*loadSet < *storeSet) {
+        *storeSet = *loadSet;
+    } else {
+        *loadSet = *storeSet;
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("store set predictor put load at: %i and store at: %i in store set: %i\n", loadPC, storePC, *loadSet);
+    #endif
+}
@@ -0,0 +1,26 @@
+
+// struct representing an entry in the last fetched store table
+typedef struct LFSTEntry {
+    int storeIndex; // store queue entry of the most recently issued store in the set, -1 once it has executed
+    unsigned int seqNum; // sequence number of that store, tells if the store queue entry was reused since
+} LFSTEntry;
+
+// struct representing the store set memory dependence predictor, loads are made to wait for the last issued store
+// of their store set, and loads and stores are put in the same set after a memory ordering violation between them
+typedef struct StoreSetPredictor {
+    int *ssit; // store set id table indexed by instruction address, -1 if the instruction has no store set
+    int numSSITEntries;
+    LFSTEntry *lfst; // last fetched store table indexed by store set id
+    int numStoreSets;
+} StoreSetPredictor;
+
+// store set predictor methods
+void initStoreSetPredictor(StoreSetPredictor *storeSets, int numSSITEntries, int numStoreSets);
+void teardownStoreSetPredictor(StoreSetPredictor *storeSets);
+int ssitIndexForPC(StoreSetPredictor *storeSets, int pc);
+int storeSetForPC(StoreSetPredictor *storeSets, int pc);
+LFSTEntry *lastFetchedStoreForPC(StoreSetPredictor *storeSets, int pc);
+void setLastFetchedStore(StoreSetPredictor *storeSets, int pc, int storeIndex, unsigned int seqNum);
+void clearLastFetchedStore(StoreSetPredictor *storeSets, int pc, int storeIndex, unsigned int seqNum);
+void flushLastFetchedStores(StoreSetPredictor *storeSets);
+void trainStoreSetPredictor(StoreSetPredictor *storeSets, int loadPC, int storePC);
@@ -11,7 +11,9 @@ enum InstructionType {
     FSUB, 
     FMUL, 
     FDIV, 
-    BNE
+    BNE,
+    JAL,
+    JALR
 };
 
 // enum representing the different types of values that an instruction can result in
@@ -37,13 +39,12 @@ enum ArchRegisterType {
     ARCH_REG_ZERO
 };
 
-// enum representing the name of a physical register
+// enum representing the name of a physical register, renamed registers are numbered from 0 up to the configured
+// number of physical registers so only the special registers are named here
 enum PhysicalRegisterName {
-    PHYS_REG_NONE = -1,
-    p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19, p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30, p31,
-    PHYS_REG_SIZE,
-    PHYS_REG_PC,
-    PHYS_REG_ZERO
+    PHYS_REG_ZERO = -3,
+    PHYS_REG_PC = -2,
+    PHYS_REG_NONE = -1
 };
 
 // enum representing the different functional unit types
@@ -63,7 +64,10 @@ enum FunctionalUnitOperations {
     FU_OP_NONE = -1,
     FU_OP_ADD,
     FU_OP_SLT,
-    FU_OP_SUB
+    FU_OP_SUB,
+    FU_OP_BNE,
+    FU_OP_JAL,
+    FU_OP_JALR
 };
 
 // enum represneting the different states that an instruction can be in
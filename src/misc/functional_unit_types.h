@@ -27,6 +27,7 @@ typedef struct BUFUResult {
     int source2;
     int isBranchTaken;
     int effAddr;
+    int linkAddr; // return address written by jumps
     int destROB;
 } BUFUResult;
 
@@ -38,14 +39,21 @@ typedef struct LSFUResult {
     int destROB;
     int fuType; // either FU_TYPE_LOAD or FU_TYPE_STORE
     float loadValue; // used in the memory unit
+    float storeValue; // value written by a store, recorded in the store queue by the memory unit
 } LSFUResult;
 
-// struct that bundles the functional units together 
+// struct that bundles the functional units together, there can be several units of each type
 typedef struct FunctionalUnits {
-    IntFunctionalUnit *intFU;
-    FPFunctionalUnit *fpAddFU;
-    FPFunctionalUnit *fpMulFU;
-    FPFunctionalUnit *fpDivFU;
-    BUFunctionalUnit *buFU;
-    LSFunctionalUnit *lsFU;
+    IntFunctionalUnit *intFUs;
+    FPFunctionalUnit *fpAddFUs;
+    FPFunctionalUnit *fpMulFUs;
+    FPFunctionalUnit *fpDivFUs;
+    BUFunctionalUnit *buFUs;
+    LSFunctionalUnit *lsFUs;
+    int numIntFUs;
+    int numFPAddFUs;
+    int numFPMulFUs;
+    int numFPDivFUs;
+    int numBUFUs;
+    int numLSFUs;
 } FunctionalUnits;
\ No newline at end of file
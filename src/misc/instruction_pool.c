@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "sim_context.h"
+#include "instruction_pool.h"
+
+// initialize an instruction pool that can hold up to capacity in flight instructions
+void initInstructionPool(InstructionPool *pool, int capacity) {
+
+    pool->capacity = capacity;
+    pool->slots = calloc(capacity, sizeof(Instruction));
+    pool->freeSlots = malloc(capacity * sizeof(int));
+
+    // every slot starts out free, push them so that slot 0 is handed out first
+    pool->numFreeSlots = capacity;
+    for (int i = 0; i < capacity; i++) {
+        pool->freeSlots[i] = capacity - 1 - i;
+    }
+}
+
+// free any elements of the instruction pool that are stored on the heap
+void teardownInstructionPool(InstructionPool *pool) {
+    if (pool->slots) {
+        free(pool->slots);
+    }
+    if (pool->freeSlots) {
+        free(pool->freeSlots);
+    }
+}
+
+// hands out an unused instruction slot from the pool
+Instruction *allocateInstruction(InstructionPool *pool) {
+
+    // the pool is sized for every instruction that can be in flight, so running out means an instruction was never released
+    if (pool->numFreeSlots == 0) {
+        printf("error: instruction pool with capacity %i is exhausted, this should never happen\n", pool->capacity);
+        exitSimulation(1);
+    }
+
+    return &pool->slots[pool->freeSlots[--pool->numFreeSlots]];
+}
+
+// returns an instruction slot to the pool once it has committed or been flushed
+void releaseInstruction(InstructionPool *pool, Instruction *inst) {
+
+    if (!inst) {
+        return;
+    }
+
+    int index = inst - pool->slots;
+
+    if (index < 0 || index >= pool->capacity || pool->numFreeSlots == pool->capacity) {
+        printf("error: tried to release instruction: %p which is not in use by the instruction pool\n", inst);
+        exitSimulation(1);
+    }
+
+    pool->freeSlots[pool->numFreeSlots++] = index;
+}
+
+// prints the current usage of the instruction pool
+void printInstructionPool(InstructionPool *pool) {
+    printf("instruction pool: capacity: %i, in use: %i\n", pool->capacity, pool->capacity - pool->numFreeSlots);
+}
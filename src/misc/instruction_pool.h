@@ -0,0 +1,17 @@
+// forward declarations
+typedef struct Instruction Instruction;
+
+// struct representing a fixed capacity slab of instructions that are recycled instead of being allocated for every fetched instruction
+typedef struct InstructionPool {
+    Instruction *slots;
+    int *freeSlots; // stack of indices of slots that are not in use
+    int numFreeSlots;
+    int capacity;
+} InstructionPool;
+
+// instruction pool methods
+void initInstructionPool(InstructionPool *pool, int capacity);
+void teardownInstructionPool(InstructionPool *pool);
+Instruction *allocateInstruction(InstructionPool *pool);
+void releaseInstruction(InstructionPool *pool, Instruction *inst);
+void printInstructionPool(InstructionPool *pool);
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "sim_context.h"
 #include "label_table.h"
 
 // intialize an instance of a label table
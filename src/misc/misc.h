@@ -1,3 +1,4 @@
+#include "sim_context.h"
 
 #include "types.h"
 #include "enums.h"
@@ -5,4 +6,5 @@
 #include "status_table_types.h"
 #include "stage_unit_types.h"
 #include "label_table.h"
+#include "instruction_pool.h"
 #include "debug.h"
\ No newline at end of file
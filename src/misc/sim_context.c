@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include "sim_context.h"
+
+// context of the simulation running on this thread, NULL outside of batch mode
+static _Thread_local SimContext *currentSimContext = NULL;
+
+// sets the context of the simulation running on this thread, NULL returns to stdout and exiting on errors
+void setSimContext(SimContext *context) {
+    currentSimContext = context;
+}
+
+// prints like printf to the output of the simulation running on this thread
+int simPrintf(const char *format, ...) {
+
+    FILE *output = currentSimContext ? currentSimContext->output : stdout;
+    if (!output) {
+        return 0;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int numChars = vfprintf(output, format, args);
+    va_end(args);
+
+    return numChars;
+}
+
+// stops the simulation running on this thread with a given exit status, a simulation with a context returns to its
+// error jump without freeing what it allocated, otherwise the process exits
+_Noreturn void exitSimulation(int status) {
+
+    if (currentSimContext) {
+        currentSimContext->errorStatus = status;
+        longjmp(currentSimContext->errorJump, 1);
+    }
+
+    exit(status);
+}
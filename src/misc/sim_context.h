@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include <setjmp.h>
+
+// struct representing where a simulation prints to and where it returns to on an error. batch mode gives every run its own
+// context on the thread running it, so runs on different threads never share output. a thread without a context prints
+// to stdout and exits the process on an error
+typedef struct SimContext {
+    FILE *output; // NULL discards everything the simulation prints
+    jmp_buf errorJump; // jumped to when the simulation hits an error
+    int errorStatus; // exit status of the error the simulation stopped with
+} SimContext;
+
+// sim context methods
+void setSimContext(SimContext *context);
+int simPrintf(const char *format, ...);
+_Noreturn void exitSimulation(int status);
+
+// every print of the simulator goes to the context of the thread running it
+#define printf(...) simPrintf(__VA_ARGS__)
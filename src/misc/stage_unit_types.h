@@ -1,6 +1,20 @@
+// forward declarations
+typedef struct DecodedInstruction DecodedInstruction;
+
 
 // struct that represents an entry in the fetch buffer
 typedef struct FetchBufferEntry {
-    char *instStr;
+    DecodedInstruction *decodedInst;
     int instAddr;
-} FetchBufferEntry;
\ No newline at end of file
+    int predictedNextPC;
+    unsigned long long branchHistory;
+} FetchBufferEntry;
+
+// struct that represents an entry in the fetch target queue, a run of consecutive instructions predicted to be executed
+// that ends at the first branch or jump
+typedef struct FetchTarget {
+    int startAddr; // address of the next instruction of the block to fetch
+    int numInsts; // instructions of the block that have not been fetched yet
+    int nextPC; // predicted address after the last instruction of the block
+    unsigned long long branchHistory; // global branch history before the branch ending the block was predicted
+} FetchTarget;
@@ -3,10 +3,12 @@
 typedef struct ROBStatusTable ROBStatusTable;
 typedef struct ResStationStatusTable ResStationStatusTable;
 typedef struct RegisterStatusTable RegisterStatusTable;
+typedef struct LoadStoreQueue LoadStoreQueue;
 
 // struct that bundles the different status tables together
 typedef struct StatusTables {
     ROBStatusTable *robTable;
     ResStationStatusTable *resStationTable;
     RegisterStatusTable *regTable;
+    LoadStoreQueue *loadStoreQueue;
 } StatusTables;
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include "sim_context.h"
 #include "types.h"
 #include "enums.h"
 
@@ -29,11 +30,20 @@ enum InstructionType stringToInstructionType(char *s) {
         return FDIV;
     } else if (!strcmp(s, "bne")) {
         return BNE;
+    } else if (!strcmp(s, "jal")) {
+        return JAL;
+    } else if (!strcmp(s, "jalr")) {
+        return JALR;
     } else {
         return INST_TYPE_NONE;
     }
 }
 
+// returns 1 if an instruction type is executed by the BU functional unit and can redirect fetch
+int instTypeIsBranchOrJump(enum InstructionType instType) {
+    return instType == BNE || instType == JAL || instType == JALR;
+}
+
 // converts an instruction type enum to string
 char *InstructionTypeToString(enum InstructionType instType) {
 
@@ -57,26 +67,30 @@ char *InstructionTypeToString(enum InstructionType instType) {
         return "fdiv";
     } else if (instType == BNE) {
         return "bne";
+    } else if (instType == JAL) {
+        return "jal";
+    } else if (instType == JALR) {
+        return "jalr";
     } else {
         return "NONE";
     }
 }
 
-// converts the rename register name enum to string
-char *physicalRegisterNameToString(enum PhysicalRegisterName reg) {
+// converts the rename register name enum to string, names of numbered registers are written to a given buffer of
+// PHYS_REG_NAME_SIZE chars so that nothing is allocated or shared between simulations
+char *physicalRegisterNameToString(enum PhysicalRegisterName reg, char *buf) {
 
-    if (reg < 0) {
-        return "NONE";
-    } else if (reg == PHYS_REG_PC) {
+    if (reg == PHYS_REG_PC) {
         return "PHYS_PC";
     } else if (reg == PHYS_REG_ZERO) {
         return "PHYS_ZERO";
+    } else if (reg < 0) {
+        return "NONE";
     }
 
-    char *str = malloc(4 * sizeof(char));
-    sprintf(str, "p%d", reg);
+    snprintf(buf, PHYS_REG_NAME_SIZE, "p%d", reg);
 
-    return str;
+    return buf;
 }
 
 // converts the instruction state enum to a string
@@ -113,6 +127,12 @@ char *fuOpToString(enum FunctionalUnitOperations op) {
         return "sub";
     } else if (op == FU_OP_SLT) {
         return "slt";
+    } else if (op == FU_OP_BNE) {
+        return "bne";
+    } else if (op == FU_OP_JAL) {
+        return "jal";
+    } else if (op == FU_OP_JALR) {
+        return "jalr";
     } else {
         return "NONE";
     }
@@ -167,48 +187,75 @@ char *branchPredictionStateToString(enum BranchPredictionState state) {
 
 // prints the contents of an instruction
 void printInstruction(Instruction inst) {
+    char destName[PHYS_REG_NAME_SIZE], source1Name[PHYS_REG_NAME_SIZE], source2Name[PHYS_REG_NAME_SIZE];
+
     printf("instruction: addr: %i, label: %s, type: %i, imm: %i, destReg: %s, sourceReg1: %s, sourceReg2: %s, ", 
-        inst.addr, inst.label, inst.type, inst.imm, inst.destReg->name, inst.source1Reg->name, inst.source2Reg->name);
-    printf("renamedDest: %s, renamedSource1: %s, renamedSource2: %s, branchTargetLabel: %s\n", physicalRegisterNameToString(inst.destPhysReg), 
-        physicalRegisterNameToString(inst.source1PhysReg), physicalRegisterNameToString(inst.source2PhysReg), inst.branchTargetLabel);
+        inst.addr, inst.label ? inst.label : "", inst.type, inst.imm, inst.destReg->name, inst.source1Reg->name, inst.source2Reg->name);
+    printf("renamedDest: %s, renamedSource1: %s, renamedSource2: %s, branchTargetLabel: %s\n", physicalRegisterNameToString(inst.destPhysReg, destName), 
+        physicalRegisterNameToString(inst.source1PhysReg, source1Name), physicalRegisterNameToString(inst.source2PhysReg, source2Name), inst.branchTargetLabel ? inst.branchTargetLabel : "");
 }
 
-// converts a given string into an arch register instance which is more easily compared
-ArchRegister *stringToArchRegister(char *s) {
+// helper macros to build the entries of the interned architectural register table
+#define INT_ARCH_REG(n) { "R" #n, n, ARCH_REG_INT }
+#define FLOAT_ARCH_REG(n) { "F" #n, n, ARCH_REG_FLOAT }
 
-    ArchRegister *reg = malloc(sizeof(ArchRegister));
-    strcpy(reg->name, s);
+// table of every architectural register, registers are interned here so that they are never allocated while simulating
+// this table is never written to, so it can be shared between any number of simulated CPUs
+static ArchRegister archRegisterTable[NUM_ARCH_REGS] = {
+    INT_ARCH_REG(0), INT_ARCH_REG(1), INT_ARCH_REG(2), INT_ARCH_REG(3), INT_ARCH_REG(4), INT_ARCH_REG(5), INT_ARCH_REG(6), INT_ARCH_REG(7),
+    INT_ARCH_REG(8), INT_ARCH_REG(9), INT_ARCH_REG(10), INT_ARCH_REG(11), INT_ARCH_REG(12), INT_ARCH_REG(13), INT_ARCH_REG(14), INT_ARCH_REG(15),
+    INT_ARCH_REG(16), INT_ARCH_REG(17), INT_ARCH_REG(18), INT_ARCH_REG(19), INT_ARCH_REG(20), INT_ARCH_REG(21), INT_ARCH_REG(22), INT_ARCH_REG(23),
+    INT_ARCH_REG(24), INT_ARCH_REG(25), INT_ARCH_REG(26), INT_ARCH_REG(27), INT_ARCH_REG(28), INT_ARCH_REG(29), INT_ARCH_REG(30), INT_ARCH_REG(31),
+    FLOAT_ARCH_REG(0), FLOAT_ARCH_REG(1), FLOAT_ARCH_REG(2), FLOAT_ARCH_REG(3), FLOAT_ARCH_REG(4), FLOAT_ARCH_REG(5), FLOAT_ARCH_REG(6), FLOAT_ARCH_REG(7),
+    FLOAT_ARCH_REG(8), FLOAT_ARCH_REG(9), FLOAT_ARCH_REG(10), FLOAT_ARCH_REG(11), FLOAT_ARCH_REG(12), FLOAT_ARCH_REG(13), FLOAT_ARCH_REG(14), FLOAT_ARCH_REG(15),
+    FLOAT_ARCH_REG(16), FLOAT_ARCH_REG(17), FLOAT_ARCH_REG(18), FLOAT_ARCH_REG(19), FLOAT_ARCH_REG(20), FLOAT_ARCH_REG(21), FLOAT_ARCH_REG(22), FLOAT_ARCH_REG(23),
+    FLOAT_ARCH_REG(24), FLOAT_ARCH_REG(25), FLOAT_ARCH_REG(26), FLOAT_ARCH_REG(27), FLOAT_ARCH_REG(28), FLOAT_ARCH_REG(29), FLOAT_ARCH_REG(30), FLOAT_ARCH_REG(31),
+    { "PC", -1, ARCH_REG_PC },
+    { "$0", -1, ARCH_REG_ZERO }
+};
+
+// returns the index of an architectural register in the interned register table
+int archRegisterIndex(ArchRegister *reg) {
+    return reg - archRegisterTable;
+}
+
+// returns the interned arch register stored at a given index of the table
+ArchRegister *archRegisterForIndex(int index) {
+    return &archRegisterTable[index];
+}
+
+// converts a given string into the interned arch register instance which is more easily compared
+ArchRegister *stringToArchRegister(char *s) {
 
     if (!strcmp(s, "PC")) {
-        reg->regType = ARCH_REG_PC;
-        reg->num = -1;
+        return &archRegisterTable[ARCH_REG_INDEX_PC];
     } else if (!strcmp(s, "$0")) {
-        reg->regType = ARCH_REG_ZERO;
-        reg->num = -1;
+        return &archRegisterTable[ARCH_REG_INDEX_ZERO];
+    }
+
+    int tableOffset;
+    if (s[0] == 'R') {
+        tableOffset = ARCH_REG_INDEX_INT_BASE;
+    } else if (s[0] == 'F') {
+        tableOffset = ARCH_REG_INDEX_FLOAT_BASE;
     } else {
-        if (s[0] == 'R') {
-            reg->regType = VALUE_TYPE_INT;
-        } else if (s[0] == 'F') {
-            reg->regType = VALUE_TYPE_FLOAT;
-        } else {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("error: could not create ArchRegister struct for the given input register: %s\n", s);
-            #endif
-
-            free(reg);
-            return NULL;
-        }
-
-        if (sscanf(s + 1, "%d", &reg->num) <= 0) {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("error: could not create ArchRegister struct for the given input register: '%s' due to an invalid\n", s);
-            #endif
-
-            return NULL;
-        }
+        #ifdef ENABLE_DEBUG_LOG
+        printf("error: could not find ArchRegister for the given input register: %s\n", s);
+        #endif
+
+        return NULL;
+    }
+
+    int num;
+    if (sscanf(s + 1, "%d", &num) <= 0 || num < 0 || num >= NUM_ARCH_REGS_PER_TYPE) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("error: could not find ArchRegister for the given input register: '%s' due to an invalid register number\n", s);
+        #endif
+
+        return NULL;
     }
     
-    return reg;
+    return &archRegisterTable[tableOffset + num];
 } 
 
 // helper method which determines if two ArchRegister structs are equal
@@ -3,10 +3,95 @@
 // struct containing parameters read from a config file
 typedef struct Params {
     int NF; // instructions fetched per cycle
+    int NFB; // fetch buffer entries between fetch and decode
+    int ftqSize; // fetch target queue entries between the branch predictor and fetch
     int NI; // decoded instruction queue length
     int NW; // instructions issued to reservation stations per cycle
     int NR; // circular ROB entries
     int NB; // common data busses 
+    int NC; // rename checkpoints for in-flight branches
+    int NP; // physical registers (only the int ones when NPF is set)
+    int NPF; // physical registers in a separate float pool, 0 to share NP with int registers
+    int ES; // skip over cycles in which no unit can make progress (event-driven mode)
+    int maxCycles; // cycles after which a program that has not finished is stopped, 0 for no limit
+
+    // reservation stations for each functional unit type
+    int numIntStations;
+    int numLoadStations;
+    int numStoreStations;
+    int numFPAddStations;
+    int numFPMulStations;
+    int numFPDivStations;
+    int numBUStations;
+
+    // functional units of each type, units of the same type share its reservation stations
+    int numIntFUs;
+    int numFPAddFUs;
+    int numFPMulFUs;
+    int numFPDivFUs;
+    int numBUFUs;
+    int numLSFUs;
+
+    // cycles taken by each functional unit type
+    int intLatency;
+    int fpAddLatency;
+    int fpMulLatency;
+    int fpDivLatency;
+    int buLatency;
+    int lsLatency;
+
+    // L1 instruction cache geometry and timing
+    int l1iSets;
+    int l1iWays;
+    int l1iLineSize; // in addresses, each instruction takes 4
+    int l1iMissLatency;
+
+    // L1 data cache geometry and timing
+    int l1dSets;
+    int l1dWays;
+    int l1dLineSize; // in addresses
+    int l1dReplacementPolicy; // enum CacheReplacementPolicy
+    int l1dHitLatency;
+    int l1dMissLatency;
+    int numMSHRs;
+
+    // unified L2 cache and memory behind the L1 data cache
+    int l2Sets; // 0 if there is no L2 cache
+    int l2Ways;
+    int l2LineSize; // in addresses
+    int l2ReplacementPolicy; // enum CacheReplacementPolicy
+    int l2Latency;
+    int dramLatency; // 0 if memory is ideal
+    int dramRequestsPerCycle;
+
+    // stride prefetcher filling a buffer next to the L1 data cache
+    int prefetchTableSize;
+    int prefetchBufferSize; // in lines
+    int prefetchDegree; // 0 if there is no prefetcher
+    int prefetchDistance; // in strides
+
+    // store set memory dependence predictor
+    int ssitSize;
+    int numStoreSets;
+
+    // branch direction predictor
+    int bpType; // enum BranchPredictorType
+    int bpPHTSize;
+    int bpGsharePHTSize;
+    int bpChooserSize;
+    int bpHistoryLength;
+    int bpTAGENumTables;
+    int bpTAGETableSize;
+    int bpTAGETagBits;
+    int bpTAGEMinHistory;
+    int bpTAGEMaxHistory;
+
+    // branch target buffer
+    int btbSets;
+    int btbWays;
+    int btbIndexShift;
+
+    int rasSize; // return address stack entries
 } Params;
 
 // struct containing information about stall statistics
@@ -15,8 +100,20 @@ typedef struct StallStats {
     int fullResStationStalls;
     int totalCDBOpenings;
     int utilizedCDBs;
+    int fullCheckpointStalls;
+    int fullMSHRStalls;
+    int fullFetchBufferStalls;
+    int icacheMissStalls;
 } StallStats;
 
+#define NUM_ARCH_REGS_PER_TYPE 32 // number of int and float architectural registers
+#define ARCH_REG_INDEX_INT_BASE 0 // index of R0 in the interned architectural register table
+#define ARCH_REG_INDEX_FLOAT_BASE NUM_ARCH_REGS_PER_TYPE // index of F0 in the interned architectural register table
+#define ARCH_REG_INDEX_PC (2 * NUM_ARCH_REGS_PER_TYPE)
+#define ARCH_REG_INDEX_ZERO (ARCH_REG_INDEX_PC + 1)
+#define NUM_ARCH_REGS (ARCH_REG_INDEX_ZERO + 1) // 32 int + 32 float + PC + $0
+#define PHYS_REG_NAME_SIZE 12 // size of a buffer that can hold the name of any physical register
+
 // struct representing an architectural register
 typedef struct ArchRegister {
     char name[8];
@@ -24,6 +121,20 @@ typedef struct ArchRegister {
     int regType; // enum ArchRegisterType
 } ArchRegister;
 
+// struct representing an instruction decoded once when the program is loaded, fetch and decode only copy these
+typedef struct DecodedInstruction {
+    int type; // enum InstructionType
+    ArchRegister *source1Reg;
+    ArchRegister *source2Reg;
+    ArchRegister *destReg;
+    int imm; // either the offset used in load/store instructions, an immediate for addi instructions, or the resolved branch offset
+    int branchTarget; // resolved target address of a branch or jal, -1 for other instructions
+    char *branchTargetLabel;
+    char *label;
+    int addr; // address in the instruction cache
+    char *fullStr;
+} DecodedInstruction;
+
 // struct representing an instruction
 typedef struct Instruction {
     int type; // enum InstructionType
@@ -35,15 +146,18 @@ typedef struct Instruction {
     int destPhysReg; // enum PhysicalRegisterName
     int regsWereRenamed;
     int imm; // either the offset used in load/store instructions or an immediate for addi instructions
-    char branchTargetLabel[256];
-    char label[256];
+    char *branchTargetLabel; // points into the decoded instruction, not owned
+    char *label; // points into the decoded instruction, not owned
     int addr; // address in the instruction cache
-    char fullStr[256];
+    char *fullStr; // points into the decoded instruction, not owned
+    int predictedNextPC; // address fetch continued from after this instruction, checked against the resolved target when a branch commits
+    unsigned long long branchHistory; // global branch history when the instruction was fetched, used to update the branch predictor
 } Instruction;
 
 // helper methods
 int stringToInstructionType(char *s);
-char *physicalRegisterNameToString(int reg); // reg = enum PhysicalRegisterName
+int instTypeIsBranchOrJump(int instType); // instType = enum InstructionType
+char *physicalRegisterNameToString(int reg, char *buf); // reg = enum PhysicalRegisterName
 void printInstruction(Instruction inst);
 char *instStateToString(int state); // state = enum InstructionState
 char *valueTypeToString(int type); // type = enum ValueType
@@ -52,4 +166,6 @@ char *fuTypeToString(int fuType); // fuType = enum FunctionalUnitType
 char *valueProducedByToString(int producedBy); // producedBy = enum ValueProducedBy
 char *branchPredictionStateToString(int state); // state = enum BranchPredictionState
 ArchRegister *stringToArchRegister(char *s);
+int archRegisterIndex(ArchRegister *reg);
+ArchRegister *archRegisterForIndex(int index);
 int archRegistersAreEqual(ArchRegister *reg1, ArchRegister *reg2);
\ No newline at end of file
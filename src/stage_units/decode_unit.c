@@ -3,254 +3,171 @@
 #include <stdlib.h>
 #include <string.h>
 #include "decode_unit.h"
+#include "fetch_unit.h"
 #include "../misc/misc.h"
 #include "../cpu.h"
 #include "../status_tables/status_tables.h"
 
 // initialize a decode unit struct
-void initDecodeUnit(DecodeUnit *decodeUnit, int NI, int NW) {
+void initDecodeUnit(DecodeUnit *decodeUnit, int NI, int NW, int NC, int NP, int NPF, int instPoolSize) {
 
     decodeUnit->NI = NI;
     decodeUnit->NW = NW;
 
+    // initialize the pool that decoded instructions are taken from
+    decodeUnit->instPool = malloc(sizeof(InstructionPool));
+    initInstructionPool(decodeUnit->instPool, instPoolSize);
+
     // initialize decode queue
     decodeUnit->decodeQueue = calloc(decodeUnit->NI, sizeof(Instruction *));
     decodeUnit->numInstsInQueue = 0;
 
-    // initialize map table (linked list of linked lists)
-    decodeUnit->mapTableHead = NULL;
+    // float registers get their own pool after the int registers if a size was given for it
+    decodeUnit->numIntPhysicalRegisters = NP;
+    decodeUnit->numPhysicalRegisters = NP + NPF;
+    decodeUnit->numFreeLists = NPF > 0 ? 2 : 1;
 
-    // initialize free list
-    RegisterMappingNode *prevNode = NULL;
-    for (int i = 0; i < PHYS_REG_SIZE; i++) {
+    // initialize map table, no arch register is mapped yet
+    decodeUnit->mapTable = malloc(NUM_ARCH_REGS * sizeof(int));
+    for (int i = 0; i < NUM_ARCH_REGS; i++) {
+        decodeUnit->mapTable[i] = PHYS_REG_NONE;
+    }
 
-        RegisterMappingNode *node = malloc(sizeof(RegisterMappingNode));
-        node->reg = i;
-        node->next = NULL;
+    // initialize the older mapping links of each physical register
+    decodeUnit->prevMapping = malloc(decodeUnit->numPhysicalRegisters * sizeof(int));
+    for (int i = 0; i < decodeUnit->numPhysicalRegisters; i++) {
+        decodeUnit->prevMapping[i] = PHYS_REG_NONE;
+    }
 
-        if (!prevNode) {
-            decodeUnit->freeList = node;
-        } else {
-            prevNode->next = node;
+    // initialize each free list with every physical register of its pool in order
+    int firstReg = 0;
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        PhysicalRegisterFreeList *freeList = &decodeUnit->freeLists[i];
+        freeList->capacity = i == 0 ? NP : NPF;
+        freeList->regs = malloc(freeList->capacity * sizeof(int));
+        for (int j = 0; j < freeList->capacity; j++) {
+            freeList->regs[j] = firstReg + j;
         }
+        freeList->head = 0;
+        freeList->numFreeRegs = freeList->capacity;
+        freeList->numRegsAllocated = 0;
 
-        prevNode = node;
+        firstReg += freeList->capacity;
     }
+
+    // initialize rename checkpoints for in-flight branches
+    decodeUnit->NC = NC;
+    decodeUnit->checkpoints = malloc(NC * sizeof(RenameCheckpoint));
+    for (int i = 0; i < NC; i++) {
+        decodeUnit->checkpoints[i].mapTable = malloc(NUM_ARCH_REGS * sizeof(int));
+    }
+    decodeUnit->oldestCheckpointIndex = 0;
+    decodeUnit->numCheckpointsInUse = 0;
 }
 
 // free any elements in the decode unit stored on the heap
 void teardownDecodeUnit(DecodeUnit *decodeUnit) {
 
-    // free the free list
-    RegisterMappingNode *currMappingNode = decodeUnit->freeList;
-    RegisterMappingNode *prevMappingNode = NULL;
-    while (currMappingNode) {
-        prevMappingNode = currMappingNode;
-        currMappingNode = currMappingNode->next;
-        free(prevMappingNode);
+    // free the map table and free list
+    free(decodeUnit->mapTable);
+    free(decodeUnit->prevMapping);
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        free(decodeUnit->freeLists[i].regs);
     }
 
-    // free the map table
-    MapTableEntry *currMapTableEntry = decodeUnit->mapTableHead;
-    MapTableEntry *prevMapTableEntry = NULL;
-    while (currMapTableEntry) {
+    // free the rename checkpoints
+    for (int i = 0; i < decodeUnit->NC; i++) {
+        free(decodeUnit->checkpoints[i].mapTable);
+    }
+    free(decodeUnit->checkpoints);
 
-        currMappingNode = currMapTableEntry->mapHead;
-        prevMappingNode = NULL;
-        
-        while (currMappingNode) {
-            prevMappingNode = currMappingNode;
-            currMappingNode = currMappingNode->next;
-            free(prevMappingNode);
-        }       
+    // the instructions left in the queue belong to the instruction pool
+    free(decodeUnit->decodeQueue);
 
-        prevMapTableEntry = currMapTableEntry;
-        currMapTableEntry = currMapTableEntry->next;
-        free(prevMapTableEntry);
+    // free the instruction pool
+    if (decodeUnit->instPool) {
+        teardownInstructionPool(decodeUnit->instPool);
+        free(decodeUnit->instPool);
     }
 }
 
-// adds an instruction to the decode queue
-void addInstructionToDecodeQueue(DecodeUnit *decodeUnit, LabelTable *labelTable, char *instStr, int instAddr) {
+// adds an instruction to the decode queue by copying its pre-decoded fields
+void addInstructionToDecodeQueue(DecodeUnit *decodeUnit, FetchBufferEntry *entry) {
 
-    // initialize instruction
-    Instruction *inst = malloc(sizeof(Instruction));
-    inst->type = INST_TYPE_NONE;
-    inst->destReg = NULL;
-    inst->source1Reg = NULL;
-    inst->source2Reg = NULL;
+    DecodedInstruction *decodedInst = entry->decodedInst;
+
+    // initialize instruction using a recycled slot from the instruction pool
+    Instruction *inst = allocateInstruction(decodeUnit->instPool);
+    inst->type = decodedInst->type;
+    inst->destReg = decodedInst->destReg;
+    inst->source1Reg = decodedInst->source1Reg;
+    inst->source2Reg = decodedInst->source2Reg;
     inst->destPhysReg = PHYS_REG_NONE;
     inst->source1PhysReg = PHYS_REG_NONE;
     inst->source2PhysReg = PHYS_REG_NONE;
-    inst->imm = 0;
-    inst->label[0] = '\0';
-    inst->branchTargetLabel[0] = '\0';
+    inst->imm = decodedInst->imm;
+    inst->label = decodedInst->label;
+    inst->branchTargetLabel = decodedInst->branchTargetLabel;
     inst->regsWereRenamed = 0;
-    inst->addr = instAddr;
-
-    // copy input string to buffer so that it does not modified by strtok
-    char instBuf[256];
-    strcpy(instBuf, instStr);
-    strcpy(inst->fullStr, instStr);
-
-    #ifdef ENABLE_DEBUG_LOG
-    printf("inst: %s\n", inst->fullStr);
-    #endif
-
-    // get the first token of the line
-    char *cur = strtok(instBuf, " \n\t,");
-
-    if (cur == NULL) {
-        exit(1);
-    }
-
-    // the first token containing a colon indicates it is a label
-    if (strstr(cur, ":")) {
-        
-        memcpy(inst->label, cur, strlen(cur)-1);
-        inst->label[strlen(cur)-1] = '\0';
-
-        cur = strtok(NULL, " \n\t,");
-    }
-    
-    // convert the instruction type to an enum
-    inst->type = stringToInstructionType(cur);
-
-    // instruction type could not be matched
-    if (inst->type == INST_TYPE_NONE) {
-        
-        printf("error: invalid instruction type '%s'\n", cur);
-        exit(1);
-
-    // memory access instructions
-    } else if (inst->type == FLD) {
-
-        inst->destReg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->imm = atoi(strtok(NULL, " \n\t,()"));
-        inst->source2Reg = stringToArchRegister(strtok(NULL, " \n\t,()"));
-
-        if (!inst->destReg || !inst->source2Reg) {
-            printf("error: invalid register in instruction: '%s'\n", instBuf);
-            exit(1);
-        }
-
-    } else if (inst->type == FSD) {
-
-        // inst->destReg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->source1Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->imm = atoi(strtok(NULL, " \n\t,()"));
-        inst->source2Reg = stringToArchRegister(strtok(NULL, " \n\t,()"));
-
-        // if (!inst->destReg || !inst->source1Reg) {
-        if (!inst->source1Reg || !inst->source2Reg) {
-            printf("error: invalid register in instruction: '%s'\n", instBuf);
-            exit(1);
-        }
-
-    // register-immediate instruction
-    } else if (inst->type == ADDI) {
-
-        inst->destReg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->source1Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->imm = atoi(strtok(NULL, " \n\t,"));
-
-        if (!inst->destReg || !inst->source1Reg) {
-            printf("error: invalid register in instruction: '%s'\n", instBuf);
-            exit(1);
-        }
-
-    // register-register instructions
-    } else if (inst->type == ADD || inst->type == SLT || inst->type == FADD || inst->type == FSUB || inst->type == FMUL || inst->type == FDIV) {
-        
-        inst->destReg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->source1Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->source2Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-
-        if (!inst->destReg || !inst->source1Reg || !inst->source2Reg) {
-            printf("error: invalid register in instruction: '%s'\n", instBuf);
-            exit(1);
-        }
-
-    // branch instruction
-    } else if (inst->type == BNE) {
-
-        inst->source1Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        inst->source2Reg = stringToArchRegister(strtok(NULL, " \n\t,"));
-        char *targetLabel = strtok(NULL, " \n\t,");
-        memcpy(inst->branchTargetLabel, targetLabel, strlen(targetLabel));
-        inst->branchTargetLabel[strlen(targetLabel)] = '\0';
-
-        // branch instructions store the pc offset to the target instruction in the imm field (in real implementations this is encoded in instruction already)
-        inst->imm = getAddressForLabel(labelTable, inst->branchTargetLabel) - inst->addr;
-
-        #ifdef ENABLE_DEBUG_LOG
-        printf("\n\n\ngetAddressForLabel: %i, inst->addr: %i\n\n\n", getAddressForLabel(labelTable, inst->branchTargetLabel), inst->addr);
-        #endif
-
-        if (!targetLabel) {
-            printf("error: invalid target label in instruction: '%s'\n", instBuf);
-            exit(1);
-        } else if (!inst->source1Reg || !inst->source2Reg) {
-            printf("error: invalid register in instruction: '%s'\n", instBuf);
-            exit(1);
-        }
-
-    } else {
-        printf("error: could not match this point should never be reached...\n");
-        exit(1);
-    }
+    inst->addr = entry->instAddr;
+    inst->fullStr = decodedInst->fullStr;
+    inst->predictedNextPC = entry->predictedNextPC;
+    inst->branchHistory = entry->branchHistory;
 
     // add the instruction to the decode queue
     decodeUnit->decodeQueue[decodeUnit->numInstsInQueue++] = inst;
 
     #ifdef ENABLE_DEBUG_LOG
-    printf("added instruction: %p to decode queue, numInstsInQueue: %i\n", inst, decodeUnit->numInstsInQueue);
+    printf("added instruction: %p (%s) to decode queue, numInstsInQueue: %i\n", inst, inst->fullStr, decodeUnit->numInstsInQueue);
     #endif
 }
 
 // prints the current state of the map table
 void printMapTable(DecodeUnit *decodeUnit) {
     
+    char regName[PHYS_REG_NAME_SIZE];
+
     printf("map table:\n");
 
-    MapTableEntry *currMapTableEntry = decodeUnit->mapTableHead;
-    while (currMapTableEntry) {
+    for (int i = 0; i < NUM_ARCH_REGS; i++) {
 
-        RegisterMappingNode *currMappingNode = currMapTableEntry->mapHead;
-        
-        if (currMappingNode) {
+        int physReg = decodeUnit->mapTable[i];
 
-            printf("\t%s: ", currMapTableEntry->reg->name);
-            
-            while (currMappingNode->next) {
-                printf("%s -> ", physicalRegisterNameToString(currMappingNode->reg));
-                currMappingNode = currMappingNode->next;
-            }
+        // skip registers that were never mapped
+        if (physReg == PHYS_REG_NONE) {
+            continue;
+        }
 
-            printf("%s\n", physicalRegisterNameToString(currMappingNode->reg));
-        } else {
-            printf("\t%s: NONE\n", currMapTableEntry->reg->name);
-        }    
+        printf("\t%s: ", archRegisterForIndex(i)->name);
 
-        currMapTableEntry = currMapTableEntry->next;
+        // print the mappings from newest to oldest
+        while (decodeUnit->prevMapping[physReg] != PHYS_REG_NONE) {
+            printf("%s -> ", physicalRegisterNameToString(physReg, regName));
+            physReg = decodeUnit->prevMapping[physReg];
+        }
+
+        printf("%s\n", physicalRegisterNameToString(physReg, regName));
     }
 }
 
 // prints the current state of the free list
 void printFreeList(DecodeUnit *decodeUnit) {
-    printf("free list: ");
+    char regName[PHYS_REG_NAME_SIZE];
 
-    RegisterMappingNode *curNode = decodeUnit->freeList;
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        PhysicalRegisterFreeList *freeList = &decodeUnit->freeLists[i];
 
-    if (curNode) {
-        while (curNode->next) {
-            printf("%s -> ", physicalRegisterNameToString(curNode->reg));
-            curNode = curNode->next;
+        printf("free list%s: ", decodeUnit->numFreeLists == 1 ? "" : (i == 0 ? " (int)" : " (float)"));
+
+        if (freeList->numFreeRegs == 0) {
+            printf("none\n");
+            continue;
         }
 
-        printf("%s\n", physicalRegisterNameToString(curNode->reg));
-    } else {
-        printf("none\n");
+        for (int j = 0; j < freeList->numFreeRegs; j++) {
+            int reg = freeList->regs[(freeList->head + j) % freeList->capacity];
+            printf("%s%s", physicalRegisterNameToString(reg, regName), j < freeList->numFreeRegs - 1 ? " -> " : "\n");
+        }
     }
 }
 
@@ -266,102 +183,93 @@ void printDecodeQueue(DecodeUnit *decodeUnit) {
     printf("\n");
 }
 
-// returns the number of rename registers available in the free list
-int numFreePhysicalRegistersAvailable(DecodeUnit *decodeUnit) {
-    
-    int numFreeRegs = 0;
-    RegisterMappingNode *curNode = decodeUnit->freeList;
-
-    if (curNode) {
-        while (curNode->next) {
-            curNode = curNode->next;
-            numFreeRegs++;
-        }
-    }
+// returns the index of the free list that physical registers for a given arch register are allocated from
+int freeListIndexForArchReg(DecodeUnit *decodeUnit, ArchRegister *reg) {
+    return decodeUnit->numFreeLists > 1 && reg->regType == ARCH_REG_FLOAT;
+}
 
-    return numFreeRegs;
+// returns the index of the free list that a given physical register belongs to
+int freeListIndexForPhysReg(DecodeUnit *decodeUnit, enum PhysicalRegisterName reg) {
+    return decodeUnit->numFreeLists > 1 && reg >= decodeUnit->numIntPhysicalRegisters;
 }
 
-// returns the next avaialble physical register in the free list
-RegisterMappingNode *getFreePhysicalRegister(DecodeUnit *decodeUnit) {
-    
-    // get the free rename register which is at the head of the free list
-    RegisterMappingNode *freeRenameReg = decodeUnit->freeList;
-    if (freeRenameReg) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("got free register: %s\n", physicalRegisterNameToString(freeRenameReg->reg));
-        #endif
-        
-        // remove the register from the free list
-        decodeUnit->freeList = freeRenameReg->next;
-        freeRenameReg->next = NULL;
-        return freeRenameReg;
+// returns the next avaialble physical register in the free list used by a given arch register
+enum PhysicalRegisterName getFreePhysicalRegister(DecodeUnit *decodeUnit, ArchRegister *reg) {
 
-    // could not allocated physical register
-    } else {
+    PhysicalRegisterFreeList *freeList = &decodeUnit->freeLists[freeListIndexForArchReg(decodeUnit, reg)];
+
+    // could not allocate physical register
+    if (freeList->numFreeRegs == 0) {
         #ifdef ENABLE_DEBUG_LOG
         printf("error: could not allocate physical register\n");
         #endif
 
-        return NULL;
+        return PHYS_REG_NONE;
     }
+
+    // get the free rename register which is at the head of the free list and remove it
+    enum PhysicalRegisterName freeRenameReg = freeList->regs[freeList->head];
+    freeList->head = (freeList->head + 1) % freeList->capacity;
+    freeList->numFreeRegs--;
+    freeList->numRegsAllocated++;
+
+    #ifdef ENABLE_DEBUG_LOG
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("got free register: %s\n", physicalRegisterNameToString(freeRenameReg, regName));
+    #endif
+
+    return freeRenameReg;
 }
 
-// returns the map table entry associated with a given register
-MapTableEntry *mapTableEntryForRegister(DecodeUnit *decodeUnit, ArchRegister *reg) {
+// returns a physical register to the head or tail of its free list
+void addPhysicalRegisterToFreeList(DecodeUnit *decodeUnit, enum PhysicalRegisterName reg, int addToTail) {
 
-    MapTableEntry *curr = decodeUnit->mapTableHead;
+    PhysicalRegisterFreeList *freeList = &decodeUnit->freeLists[freeListIndexForPhysReg(decodeUnit, reg)];
+    char regName[PHYS_REG_NAME_SIZE];
 
-    if (!curr || !reg) {
-        return NULL;
+    if (freeList->numFreeRegs == freeList->capacity) {
+        printf("error: tried to add physical register: %s to a full free list\n", physicalRegisterNameToString(reg, regName));
+        return;
     }
 
-    // loop through all entries in the map table
-    while (curr) { 
+    // add physical register to end of the free list
+    if (addToTail) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("adding physical register: %s to the end of the free list\n", physicalRegisterNameToString(reg, regName));
+        #endif
 
-        // check if the current map table entry matches the given register details
-        if (archRegistersAreEqual(reg, curr->reg)) {
-            return curr;
-        }
-        curr = curr->next;
+        freeList->regs[(freeList->head + freeList->numFreeRegs) % freeList->capacity] = reg;
+
+    // add physical register to head of free list
+    } else {
+        freeList->head = (freeList->head + freeList->capacity - 1) % freeList->capacity;
+        freeList->regs[freeList->head] = reg;
     }
 
-    return NULL;
+    freeList->numFreeRegs++;
 }
 
 // returns the current mapped physical register for a given architecture register
 enum PhysicalRegisterName physicalRegisterMappingForReg(DecodeUnit *decodeUnit, ArchRegister *reg) {
 
-    MapTableEntry *entry = mapTableEntryForRegister(decodeUnit, reg);
-
-    if (entry && entry->mapHead) {
-        return entry->mapHead->reg;
-    } else {
+    if (!reg) {
         return PHYS_REG_NONE;
     }
+
+    return decodeUnit->mapTable[archRegisterIndex(reg)];
 }
 
-// adds a free physical register node to the map table for a given register
-void addPhysicalRegisterToMapTable(DecodeUnit *decodeUnit, RegisterMappingNode *physRegNode, ArchRegister *reg) {
+// maps a free physical register to a given register, the previous mapping is kept as the older one
+void addPhysicalRegisterToMapTable(DecodeUnit *decodeUnit, enum PhysicalRegisterName physReg, ArchRegister *reg) {
 
     #ifdef ENABLE_DEBUG_LOG
-    printf("add physical register: %s to map table for: %s\n", physicalRegisterNameToString(physRegNode->reg), reg->name);
+    char regName[PHYS_REG_NAME_SIZE];
+    printf("add physical register: %s to map table for: %s\n", physicalRegisterNameToString(physReg, regName), reg->name);
     #endif
 
-    MapTableEntry *mapTableEntry = mapTableEntryForRegister(decodeUnit, reg);
-
-    // the given register currently does not have a map table entry, add it
-    if (!mapTableEntry) {
-        mapTableEntry = malloc(sizeof(MapTableEntry));
-        mapTableEntry->reg = reg;
-        mapTableEntry->next = decodeUnit->mapTableHead;
-        decodeUnit->mapTableHead = mapTableEntry;
-    }
-
-    // add it to the map table
-    RegisterMappingNode *regMapHead = mapTableEntry->mapHead;
-    physRegNode->next = regMapHead;
-    mapTableEntry->mapHead = physRegNode;
+    int regIndex = archRegisterIndex(reg);
+    decodeUnit->prevMapping[physReg] = decodeUnit->mapTable[regIndex];
+    decodeUnit->mapTable[regIndex] = physReg;
 }
 
 // gets the rename register currently mapped to a given register
@@ -377,249 +285,223 @@ enum PhysicalRegisterName readMapTableForReg(DecodeUnit *decodeUnit, ArchRegiste
     } else if (reg->regType == ARCH_REG_ZERO) {
         return PHYS_REG_ZERO;
     }
-    
-    MapTableEntry *entry = mapTableEntryForRegister(decodeUnit, reg);
 
-    if (entry) {
-        return entry->mapHead->reg;
-    } else {
-        return PHYS_REG_NONE;
-    }
+    return decodeUnit->mapTable[archRegisterIndex(reg)];
 }
 
-// returns the number of physical register 
-int numPhysicalRegisterMappingsForReg(DecodeUnit *decodeUnit, ArchRegister *reg) {
-    MapTableEntry *entry = mapTableEntryForRegister(decodeUnit, reg);
+// called when the instruction writing a physical register commits. the mapping it replaced is the oldest one for
+// its arch register (older writers have already committed), so it is removed and added back to the free list
+void popOldPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, enum PhysicalRegisterName committedReg, int addToTail) {
 
-    if (!entry) {
-        return 0;
-    }
+    #ifdef ENABLE_DEBUG_LOG
+    printMapTable(decodeUnit);
+    #endif
+
+    enum PhysicalRegisterName oldReg = decodeUnit->prevMapping[committedReg];
 
-    int numMappings = 0;
-    RegisterMappingNode *curr = entry->mapHead;
+    // do not pop if the committed register is the only committed mapping
+    if (oldReg == PHYS_REG_NONE) {
+        #ifdef ENABLE_DEBUG_LOG
+        char regName[PHYS_REG_NAME_SIZE];
+        printf("error: tried to pop the mapping older than: %s but there are no older mappings\n", physicalRegisterNameToString(committedReg, regName));
+        #endif
 
-    while (curr) {
-        numMappings++;
-        curr = curr->next;
+        return;
     }
 
-    return numMappings;
+    // the committed register is now the oldest mapping
+    decodeUnit->prevMapping[committedReg] = PHYS_REG_NONE;
+
+    addPhysicalRegisterToFreeList(decodeUnit, oldReg, addToTail);
 }
 
-// get the last physical register node in the free list
-RegisterMappingNode *getFreeListTailNode(DecodeUnit *decodeUnit) {
+// returns 1 if a rename checkpoint is available for a branch being issued, 0 if all are in use
+int isFreeRenameCheckpoint(DecodeUnit *decodeUnit) {
+    return decodeUnit->numCheckpointsInUse < decodeUnit->NC;
+}
 
-    RegisterMappingNode *curr = decodeUnit->freeList;
+// snapshots the map table and free list for a branch that was just renamed
+void takeRenameCheckpoint(DecodeUnit *decodeUnit) {
 
-    // return NULL if the free list is currently empty
-    if (!curr) {
-        return NULL;
-    }
+    // this method assumes that checkpoint availability was checked before it was called
+    int index = (decodeUnit->oldestCheckpointIndex + decodeUnit->numCheckpointsInUse) % decodeUnit->NC;
+    RenameCheckpoint *checkpoint = &decodeUnit->checkpoints[index];
 
-    // get the tail node
-    while (curr->next) {
-        curr = curr->next;
+    memcpy(checkpoint->mapTable, decodeUnit->mapTable, NUM_ARCH_REGS * sizeof(int));
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        checkpoint->freeListHeads[i] = decodeUnit->freeLists[i].head;
+        checkpoint->numRegsAllocated[i] = decodeUnit->freeLists[i].numRegsAllocated;
     }
 
-    return curr;
-}
-
-// removes the oldest physical register in the map table for a given register and adds it back to the free list
-void popOldPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, ROBStatusTable *robTable, ArchRegister *reg, int addToTail) {
+    decodeUnit->numCheckpointsInUse++;
 
     #ifdef ENABLE_DEBUG_LOG
-    printMapTable(decodeUnit);
+    printf("took rename checkpoint: %i, numCheckpointsInUse: %i\n", index, decodeUnit->numCheckpointsInUse);
     #endif
+}
 
-    MapTableEntry *entry = mapTableEntryForRegister(decodeUnit, reg);
+// discards the checkpoint of the oldest in-flight branch once it commits with a correct prediction
+void releaseOldestRenameCheckpoint(DecodeUnit *decodeUnit) {
 
-    if (!entry) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("error: tried to pop oldest physical register mapping for reg: %s which does not have a map table entry\n", reg->name);
-        #endif
-        
+    if (decodeUnit->numCheckpointsInUse == 0) {
+        printf("error: tried to release a rename checkpoint but none are in use\n");
         return;
     }
 
-    // do not pop regiseter if there is only one or zero in the map table
-    int numMappings = numPhysicalRegisterMappingsForReg(decodeUnit, reg);
-    if (numMappings <= 1) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("error: tried to pop a mapping for reg: %s but there are no older mappings\n", reg->name);
-        #endif
+    decodeUnit->oldestCheckpointIndex = (decodeUnit->oldestCheckpointIndex + 1) % decodeUnit->NC;
+    decodeUnit->numCheckpointsInUse--;
+}
 
+// restores the rename state to the checkpoint of the oldest in-flight branch after it was mispredicted. every
+// younger instruction is flushed, so the remaining checkpoints are discarded as well
+void restoreOldestRenameCheckpoint(DecodeUnit *decodeUnit) {
+
+    if (decodeUnit->numCheckpointsInUse == 0) {
+        printf("error: tried to restore a rename checkpoint but none are in use\n");
         return;
     }
 
-    // track the number of "new" writes to the architectural register
-    int numNewWritesToReg = 0;
-
-    // get the oldest mapping for the register
-    RegisterMappingNode *curr = entry->mapHead;
-    RegisterMappingNode *prev = NULL;
-    while (curr->next) {
-        prev = curr;
-        curr = curr->next;
+    RenameCheckpoint *checkpoint = &decodeUnit->checkpoints[decodeUnit->oldestCheckpointIndex];
 
-        if (physicalRegWillBeWrittenBySomeROB(robTable, prev->reg)) {
-            numNewWritesToReg++;
-        }
-    }
+    #ifdef ENABLE_DEBUG_LOG
+    printf("restoring rename checkpoint: %i\n", decodeUnit->oldestCheckpointIndex);
+    #endif
 
-    // don't pop if there is only one committed mapping
-    if (numNewWritesToReg == numMappings - 1) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("error: tried to pop a mapping for reg: %s but there is only one committed physical register\n", reg->name);
-        #endif
+    memcpy(decodeUnit->mapTable, checkpoint->mapTable, NUM_ARCH_REGS * sizeof(int));
 
-        return;
+    // registers allocated since the checkpoint are still in the free list buffer in front of the head (registers
+    // freed since then were added behind the tail), so moving the head back reclaims them
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        PhysicalRegisterFreeList *freeList = &decodeUnit->freeLists[i];
+        freeList->numFreeRegs += freeList->numRegsAllocated - checkpoint->numRegsAllocated[i];
+        freeList->head = checkpoint->freeListHeads[i];
+        freeList->numRegsAllocated = checkpoint->numRegsAllocated[i];
     }
 
-    // remove the last node from the mapping list
-    prev->next = NULL;
+    decodeUnit->oldestCheckpointIndex = 0;
+    decodeUnit->numCheckpointsInUse = 0;
+}
 
-    // add physical register to end of the free list
-    if (addToTail) {
-        RegisterMappingNode *freeListTail = getFreeListTailNode(decodeUnit);
+// rolls the map table back to the committed mappings when every instruction after the ROB head was flushed without a
+// rename checkpoint. the oldest mapping of each arch register is the committed one, the newer ones are freed
+void restoreCommittedRenameState(DecodeUnit *decodeUnit) {
 
-        #ifdef ENABLE_DEBUG_LOG
-        printf("adding physical register: %s to the end of the free list\n", physicalRegisterNameToString(curr->reg));
-        #endif
+    printf_DEBUG(("restoring the committed rename state\n"));
 
-        // add the physical register node to the end of the free list
-        if (freeListTail) {
-            freeListTail->next = curr;
-        
-        // the free list is currently empty, set the popped node as the head
-        } else {
-            decodeUnit->freeList = curr;
-        }
-    
-    // add physical register to head of free list
-    } else {
-        curr->next = decodeUnit->freeList;
-        decodeUnit->freeList = curr;
-    }
-}
+    for (int i = 0; i < NUM_ARCH_REGS; i++) {
+        int reg = decodeUnit->mapTable[i];
 
-// removes the newest physical register in the map table for a given register and adds it back to the free list
-void popNewPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, ArchRegister *reg, int addToTail) {
+        if (reg == PHYS_REG_NONE) {
+            continue;
+        }
 
-    MapTableEntry *entry = mapTableEntryForRegister(decodeUnit, reg);
+        while (decodeUnit->prevMapping[reg] != PHYS_REG_NONE) {
+            int olderReg = decodeUnit->prevMapping[reg];
 
-    if (!entry) {
-        printf("error: tried to pop newest physical register mapping for reg: %s which does not have a map table entry\n", reg->name);
-        return;
-    }
+            decodeUnit->prevMapping[reg] = PHYS_REG_NONE;
+            addPhysicalRegisterToFreeList(decodeUnit, reg, 0);
+            reg = olderReg;
+        }
 
-    RegisterMappingNode *poppedNode = entry->mapHead;
-    
-    #ifdef ENABLE_DEBUG_LOG
-    if (!poppedNode) {
-        printf("error: tried to pop newest node for register: %s but it does not exist\n", reg->name);
-    } else {
-        printf("popping mapping: %s from map table for: %s\n", physicalRegisterNameToString(poppedNode->reg), reg->name);
+        decodeUnit->mapTable[i] = reg;
     }
-    #endif
 
-    entry->mapHead = poppedNode->next;
-    poppedNode->next = NULL;
+    // the flushed branches no longer need their checkpoints
+    decodeUnit->oldestCheckpointIndex = 0;
+    decodeUnit->numCheckpointsInUse = 0;
+}
 
-    // add physical register to end of the free list
-    if (addToTail) {
-        RegisterMappingNode *freeListTail = getFreeListTailNode(decodeUnit);
+// counts a register allocation for a source register that has not been mapped yet
+void countUnmappedSourceRegister(DecodeUnit *decodeUnit, ArchRegister *reg, int *numNeeded) {
 
-        #ifdef ENABLE_DEBUG_LOG
-        printf("adding physical register: %s to the end of the free list\n", physicalRegisterNameToString(poppedNode->reg));
-        #endif
+    // PC and $0 are never renamed
+    if (reg->regType != ARCH_REG_INT && reg->regType != ARCH_REG_FLOAT) {
+        return;
+    }
 
-        // add the physical register node to the end of the free list
-        if (freeListTail) {
-            freeListTail->next = poppedNode;
-        
-        // the free list is currently empty, set the popped node as the head
-        } else {
-            decodeUnit->freeList = poppedNode;
-        }
-    
-    // add physical register to head of free list
-    } else {
-        poppedNode->next = decodeUnit->freeList;
-        decodeUnit->freeList = poppedNode;
+    if (physicalRegisterMappingForReg(decodeUnit, reg) == PHYS_REG_NONE) {
+        numNeeded[freeListIndexForArchReg(decodeUnit, reg)]++;
     }
 }
 
-// returns the number of physical registers that need to be allocated for a given instruction
-int numPhysicalRegistersNeededForInst(DecodeUnit *decodeUnit, Instruction *inst) {
+// counts the physical registers that need to be allocated from each free list for a given instruction
+void numPhysicalRegistersNeededForInst(DecodeUnit *decodeUnit, Instruction *inst, int *numNeeded) {
 
-    int numNeeded = 0;
+    for (int i = 0; i < MAX_PHYS_REG_POOLS; i++) {
+        numNeeded[i] = 0;
+    }
 
     // check needed free physical allocations for each instruction type
-    if (inst->type == FLD || inst->type == ADDI) {
-        
-        // always need to allocate a register for the destination register
-        numNeeded++;
+    if (inst->type == ADDI) {
 
         // check if source register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source2Reg) == PHYS_REG_NONE) {
-            numNeeded++;
-        }
+        countUnmappedSourceRegister(decodeUnit, inst->source1Reg, numNeeded);
 
-    } else if (inst->type == FSD) {
+        // always need to allocate a register for the destination register
+        numNeeded[freeListIndexForArchReg(decodeUnit, inst->destReg)]++;
 
-        // check if dest register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source1Reg) == PHYS_REG_NONE) {
-            numNeeded++;
-        }
+    } else if (inst->type == FLD) {
 
         // check if source register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source2Reg) == PHYS_REG_NONE) {
-            numNeeded++;
-        }
+        countUnmappedSourceRegister(decodeUnit, inst->source2Reg, numNeeded);
+
+        // always need to allocate a register for the destination register
+        numNeeded[freeListIndexForArchReg(decodeUnit, inst->destReg)]++;
 
     } else if (inst->type == ADD || inst->type == SLT || inst->type == FADD || inst->type == FSUB || inst->type == FMUL || inst->type == FDIV) {
-        
+
+        // check if source registers don't have a mapping
+        countUnmappedSourceRegister(decodeUnit, inst->source1Reg, numNeeded);
+        countUnmappedSourceRegister(decodeUnit, inst->source2Reg, numNeeded);
+
         // always need to allocate a register for the destination register
-        numNeeded++;
+        numNeeded[freeListIndexForArchReg(decodeUnit, inst->destReg)]++;
 
-        // check if source1 register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source1Reg) == PHYS_REG_NONE) {
-            numNeeded++;
-        }
+    } else if (inst->type == FSD || inst->type == BNE) {
 
-        // check if source2 register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source2Reg) == PHYS_REG_NONE) {
-            numNeeded++;
-        }
+        // check if source registers don't have a mapping
+        countUnmappedSourceRegister(decodeUnit, inst->source1Reg, numNeeded);
+        countUnmappedSourceRegister(decodeUnit, inst->source2Reg, numNeeded);
 
-    } else if (inst->type == BNE) {
-        
-        // check if source1 register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source1Reg) == PHYS_REG_NONE) {
-            numNeeded++;
+    } else if (inst->type == JAL || inst->type == JALR) {
+
+        // jalr reads the register holding its target
+        if (inst->type == JALR) {
+            countUnmappedSourceRegister(decodeUnit, inst->source1Reg, numNeeded);
         }
 
-        // check if source2 register doesn't have a mapping
-        if (physicalRegisterMappingForReg(decodeUnit, inst->source2Reg) == PHYS_REG_NONE) {
-            numNeeded++;
+        // the return address is written to the destination register unless it is discarded
+        if (inst->destReg) {
+            numNeeded[freeListIndexForArchReg(decodeUnit, inst->destReg)]++;
         }
+
     } else {
         #ifdef ENABLE_DEBUG_LOG
         printf("error: could not match instruction type during register renaming, this should never happen\n");
         #endif
     }
+}
+
+// returns 1 if every physical register a given instruction needs to allocate is available, 0 if not
+int physicalRegistersAvailableForInst(DecodeUnit *decodeUnit, Instruction *inst) {
+
+    int numNewPhysRegsNeeded[MAX_PHYS_REG_POOLS];
+    numPhysicalRegistersNeededForInst(decodeUnit, inst, numNewPhysRegsNeeded);
+
+    for (int i = 0; i < decodeUnit->numFreeLists; i++) {
+        if (decodeUnit->freeLists[i].numFreeRegs < numNewPhysRegsNeeded[i]) {
+            return 0;
+        }
+    }
 
-    return numNeeded;
+    return 1;
 }
 
 // rename architectural registers to physical registers for a given instruction. returns 1 if renaming was successful, 0 if not
 int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
-    int numPhysRegsAvailable = numFreePhysicalRegistersAvailable(decodeUnit);
-    int numNewPhysRegsNeeded = numPhysicalRegistersNeededForInst(decodeUnit, inst);
-
     // more physical registers need to be allocated than are currently available, renaming cannot proceed
-    if (numPhysRegsAvailable < numNewPhysRegsNeeded) {
+    if (!physicalRegistersAvailableForInst(decodeUnit, inst)) {
         return 0;
     }
     
@@ -630,16 +512,14 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
         // check if source register doesn't have a mapping
         if (source1PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source1Reg);
-            source1PhysReg = freeNode->reg;
+            source1PhysReg = getFreePhysicalRegister(decodeUnit, inst->source1Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source1PhysReg, inst->source1Reg);
         }
         inst->source1PhysReg = source1PhysReg;
 
         // always get new physical register for destination
-        RegisterMappingNode *destFreeNode = getFreePhysicalRegister(decodeUnit);
-        addPhysicalRegisterToMapTable(decodeUnit, destFreeNode, inst->destReg);
-        inst->destPhysReg = destFreeNode->reg;
+        inst->destPhysReg = getFreePhysicalRegister(decodeUnit, inst->destReg);
+        addPhysicalRegisterToMapTable(decodeUnit, inst->destPhysReg, inst->destReg);
 
     } else if (inst->type == FLD) {
 
@@ -648,16 +528,14 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
         // check if source register doesn't have a mapping
         if (source2PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source2Reg);
-            source2PhysReg = freeNode->reg;
+            source2PhysReg = getFreePhysicalRegister(decodeUnit, inst->source2Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source2PhysReg, inst->source2Reg);
         }
         inst->source2PhysReg = source2PhysReg;
 
         // always get new physical register for this instruction's destinations
-        RegisterMappingNode *destFreeNode = getFreePhysicalRegister(decodeUnit);
-        addPhysicalRegisterToMapTable(decodeUnit, destFreeNode, inst->destReg);
-        inst->destPhysReg = destFreeNode->reg;
+        inst->destPhysReg = getFreePhysicalRegister(decodeUnit, inst->destReg);
+        addPhysicalRegisterToMapTable(decodeUnit, inst->destPhysReg, inst->destReg);
 
     } else if (inst->type == FSD) {
 
@@ -667,17 +545,15 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
         // check if source1 register doesn't have a mapping
         if (source1PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source1Reg);
-            source1PhysReg = freeNode->reg;
+            source1PhysReg = getFreePhysicalRegister(decodeUnit, inst->source1Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source1PhysReg, inst->source1Reg);
         }
         inst->source1PhysReg = source1PhysReg;
 
         // check if source2 register doesn't have a mapping
         if (source2PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source2Reg);
-            source2PhysReg = freeNode->reg;
+            source2PhysReg = getFreePhysicalRegister(decodeUnit, inst->source2Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source2PhysReg, inst->source2Reg);
         }
         inst->source2PhysReg = source2PhysReg;
 
@@ -689,24 +565,21 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
         // check if source1 register doesn't have a mapping
         if (source1PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source1Reg);
-            source1PhysReg = freeNode->reg;
+            source1PhysReg = getFreePhysicalRegister(decodeUnit, inst->source1Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source1PhysReg, inst->source1Reg);
         }
         inst->source1PhysReg = source1PhysReg;
 
         // check if source2 register doesn't have a mapping
         if (source2PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source2Reg);
-            source2PhysReg = freeNode->reg;
+            source2PhysReg = getFreePhysicalRegister(decodeUnit, inst->source2Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source2PhysReg, inst->source2Reg);
         }
         inst->source2PhysReg = source2PhysReg;
 
         // always get new physical register for these instructions' destinations
-        RegisterMappingNode *destFreeNode = getFreePhysicalRegister(decodeUnit);
-        addPhysicalRegisterToMapTable(decodeUnit, destFreeNode, inst->destReg);
-        inst->destPhysReg = destFreeNode->reg;
+        inst->destPhysReg = getFreePhysicalRegister(decodeUnit, inst->destReg);
+        addPhysicalRegisterToMapTable(decodeUnit, inst->destPhysReg, inst->destReg);
 
     } else if (inst->type == BNE) {
         
@@ -716,20 +589,38 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 
         // check if source1 register doesn't have a mapping
         if (source1PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source1Reg);
-            source1PhysReg = freeNode->reg;
+            source1PhysReg = getFreePhysicalRegister(decodeUnit, inst->source1Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source1PhysReg, inst->source1Reg);
         }
         inst->source1PhysReg = source1PhysReg;
 
         // check if source2 register doesn't have a mapping
         if (source2PhysReg == PHYS_REG_NONE) {
-            RegisterMappingNode *freeNode = getFreePhysicalRegister(decodeUnit);
-            addPhysicalRegisterToMapTable(decodeUnit, freeNode, inst->source2Reg);
-            source2PhysReg = freeNode->reg;
+            source2PhysReg = getFreePhysicalRegister(decodeUnit, inst->source2Reg);
+            addPhysicalRegisterToMapTable(decodeUnit, source2PhysReg, inst->source2Reg);
         }
         inst->source2PhysReg = source2PhysReg;
 
+    } else if (inst->type == JAL || inst->type == JALR) {
+
+        // get the mapping of the register holding the jalr target
+        if (inst->type == JALR) {
+            enum PhysicalRegisterName source1PhysReg = readMapTableForReg(decodeUnit, inst->source1Reg);
+
+            // check if source register doesn't have a mapping
+            if (source1PhysReg == PHYS_REG_NONE) {
+                source1PhysReg = getFreePhysicalRegister(decodeUnit, inst->source1Reg);
+                addPhysicalRegisterToMapTable(decodeUnit, source1PhysReg, inst->source1Reg);
+            }
+            inst->source1PhysReg = source1PhysReg;
+        }
+
+        // get new physical register for the return address
+        if (inst->destReg) {
+            inst->destPhysReg = getFreePhysicalRegister(decodeUnit, inst->destReg);
+            addPhysicalRegisterToMapTable(decodeUnit, inst->destPhysReg, inst->destReg);
+        }
+
     } else {
         #ifdef ENABLE_DEBUG_LOG
         printf("error: could not match instruction type during register renaming, this should never happen\n");
@@ -742,7 +633,7 @@ int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst) {
 }
 
 // execute decode unit's operations during a clock cycle
-void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int *numInstsInBuffer, StatusTables *statusTables, RegisterFile *regFile, StallStats *stallStats, LabelTable *labelTable) {
+void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchUnit *fetchUnit, StatusTables *statusTables, RegisterFile *regFile, StallStats *stallStats) {
 
     #ifdef ENABLE_DEBUG_LOG
     printf("\nperforming decode unit operations...\n");
@@ -752,41 +643,17 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
     ResStationStatusTable *resStationTable = statusTables->resStationTable;
     RegisterStatusTable *regTable = statusTables->regTable;
 
-    int numInstsMovedToQueue = 0;
-
-    // loop through all instructions in the input buffer
-    for (int i = 0; i < *numInstsInBuffer; i++) {
-        FetchBufferEntry *entry = fetchBuffer[i];
-
-        if (!entry) {
-            printf("error: was unable to get instruction from decode input buffer when expected\n");
-            exit(1);
-        }
-
-        // attempt to add instruction to the decode queue
-        if (decodeUnit->numInstsInQueue < decodeUnit->NI) {
-            addInstructionToDecodeQueue(decodeUnit, labelTable, entry->instStr, entry->instAddr);
-            numInstsMovedToQueue++;
-        } else {
-            // exit loop if queue is full
-            break;
-        }
+    // move instructions from the head of the fetch buffer into the decode queue until it is full
+    FetchBufferEntry *entry;
+    while (decodeUnit->numInstsInQueue < decodeUnit->NI && (entry = fetchBufferHead(fetchUnit))) {
+        addInstructionToDecodeQueue(decodeUnit, entry);
+        removeFetchBufferHead(fetchUnit);
     }
 
     #ifdef ENABLE_DEBUG_LOG
     printf("numInstsInQueue: %i\n", decodeUnit->numInstsInQueue);
     #endif
 
-    // remove instructions from fetch buffer that were moved to the decode queue
-    if (numInstsMovedToQueue > 0) {
-        for (int i = numInstsMovedToQueue; i < *numInstsInBuffer; i++) {
-            free(fetchBuffer[i - numInstsMovedToQueue]); // TODO: keep free here??
-            fetchBuffer[i - numInstsMovedToQueue] = fetchBuffer[i];
-            fetchBuffer[i] = NULL;
-        }
-        *numInstsInBuffer -= numInstsMovedToQueue;
-    }
-
     // check if there are any instructions in the decode queue
     if (decodeUnit->numInstsInQueue == 0) {
         #ifdef ENABLE_DEBUG_LOG
@@ -841,8 +708,11 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
         //     break;
         // }
 
+        // branches and jumps also need a rename checkpoint to recover from a misprediction
+        int needsCheckpoint = instTypeIsBranchOrJump(instType);
+
         // issue instruction if free slot in ROB and reservation station is available
-        if (isFreeEntryInROB(robTable) && isFreeResStationForInstruction(resStationTable, inst)) {
+        if (isFreeEntryInROB(robTable) && isFreeResStationForInstruction(resStationTable, inst) && (!needsCheckpoint || isFreeRenameCheckpoint(decodeUnit))) {
             
             int renamingWasSuccessful = performRegisterRenamingForInst(decodeUnit, inst);
             if (!renamingWasSuccessful) {
@@ -855,6 +725,11 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
             
             numInstsIssued++;
 
+            // snapshot the rename state after the branch's own registers were mapped, a jump's return address is kept on recovery
+            if (needsCheckpoint) {
+                takeRenameCheckpoint(decodeUnit);
+            }
+
             #ifdef ENABLE_DEBUG_LOG
             printInstruction(*inst);
             printf("renaming was successful\n");
@@ -863,6 +738,11 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
             // add entry in the ROB for the given instruction and get the index it is stored at
             int robIndex = addInstToROB(robTable, inst);
 
+            // loads and stores also take an entry in the load/store queue in program order
+            if (instType == FLD || instType == FSD) {
+                addInstToLoadStoreQueue(statusTables->loadStoreQueue, robIndex, robTable->entries[robIndex].fuType, inst->addr);
+            }
+
             // add the values to the reservation station (just updating the reservation station table)
             addInstToResStation(resStationTable, regTable, regFile, inst, robIndex);
 
@@ -886,6 +766,14 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
                 #ifdef ENABLE_DEBUG_LOG
                 printf("encountered stall in issue unit due to reservation stations needed by the instruction being full, fullResStationStalls: %i\n", stallStats->fullResStationStalls);
                 #endif
+
+            // check if the failure to issue was caused by every rename checkpoint being in use
+            } else if (needsCheckpoint && !isFreeRenameCheckpoint(decodeUnit)) {
+                stallStats->fullCheckpointStalls++;
+
+                #ifdef ENABLE_DEBUG_LOG
+                printf("encountered stall in issue unit due to no rename checkpoints being available, fullCheckpointStalls: %i\n", stallStats->fullCheckpointStalls);
+                #endif
             }
 
             break;
@@ -905,11 +793,44 @@ void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int
     }
 }
 
+// returns 1 if the decode unit cannot move or issue any instruction in the next cycle. the stall statistic that it
+// increments in every such cycle is returned through stallCounter (NULL if there is none)
+int decodeUnitIsIdle(DecodeUnit *decodeUnit, int numInstsInBuffer, StatusTables *statusTables, StallStats *stallStats, int **stallCounter) {
+
+    *stallCounter = NULL;
+
+    // instructions can be moved from the fetch buffer into the decode queue
+    if (numInstsInBuffer > 0 && decodeUnit->numInstsInQueue < decodeUnit->NI) {
+        return 0;
+    }
+
+    if (decodeUnit->numInstsInQueue == 0) {
+        return 1;
+    }
+
+    // check the same conditions that stop the next instruction from issuing in cycleDecodeUnit
+    Instruction *inst = decodeUnit->decodeQueue[0];
+
+    if (!isFreeEntryInROB(statusTables->robTable)) {
+        *stallCounter = &stallStats->fullROBStalls;
+        return 1;
+    } else if (!isFreeResStationForInstruction(statusTables->resStationTable, inst)) {
+        *stallCounter = &stallStats->fullResStationStalls;
+        return 1;
+    } else if (instTypeIsBranchOrJump(inst->type) && !isFreeRenameCheckpoint(decodeUnit)) {
+        *stallCounter = &stallStats->fullCheckpointStalls;
+        return 1;
+    }
+
+    return !physicalRegistersAvailableForInst(decodeUnit, inst);
+}
+
 // clears all instructions in the fetch buffer and decode queue
 void flushDecodeQueue(DecodeUnit *decodeUnit) {
 
-    // clear decode queue
+    // clear decode queue and return its instructions to the pool
     for (int i = 0; i < decodeUnit->numInstsInQueue; i++) {
+        releaseInstruction(decodeUnit->instPool, decodeUnit->decodeQueue[i]);
         decodeUnit->decodeQueue[i] = NULL;
     }
     decodeUnit->numInstsInQueue = 0;
@@ -1,27 +1,32 @@
 
 // forward declarations
 typedef struct Instruction Instruction;
-typedef struct RegisterMappingNode RegisterMappingNode;
 typedef struct StatusTables StatusTables;
 typedef struct RegisterFile RegisterFile;
 typedef struct StallStats StallStats;
 typedef struct ArchRegister ArchRegister;
-typedef struct LabelTable LabelTable;
+typedef struct DecodedInstruction DecodedInstruction;
 typedef struct FetchBufferEntry FetchBufferEntry;
-typedef struct ROBStatusTable ROBStatusTable;
+typedef struct FetchUnit FetchUnit;
+typedef struct InstructionPool InstructionPool;
 
-// struct representing a node storing register information for the mapping table and free list
-typedef struct RegisterMappingNode {
-    int reg; // enum PhysicalRegisterName
-    struct RegisterMappingNode *next;
-} RegisterMappingNode;
+#define MAX_PHYS_REG_POOLS 2 // int and float registers can either share one pool or use separate ones
 
-// struct representing an entry in the map table
-typedef struct MapTableEntry {
-    ArchRegister *reg;
-    RegisterMappingNode *mapHead;
-    struct MapTableEntry *next;
-} MapTableEntry;
+// struct representing a circular free list of physical registers, registers are allocated from the head
+typedef struct PhysicalRegisterFreeList {
+    int *regs; // enum PhysicalRegisterName
+    int capacity;
+    int head;
+    int numFreeRegs;
+    unsigned int numRegsAllocated; // total registers taken from the free list, wraps around
+} PhysicalRegisterFreeList;
+
+// struct representing a snapshot of the rename state taken when a branch is issued
+typedef struct RenameCheckpoint {
+    int *mapTable; // enum PhysicalRegisterName, copy of the decode unit's map table
+    int freeListHeads[MAX_PHYS_REG_POOLS];
+    unsigned int numRegsAllocated[MAX_PHYS_REG_POOLS]; // allocation counts at the time of the snapshot, used to find the registers to reclaim
+} RenameCheckpoint;
 
 // struct representing a decode unit
 typedef struct DecodeUnit {
@@ -29,28 +34,52 @@ typedef struct DecodeUnit {
     int numInstsInQueue;
     int NI;
     int NW;
-    RegisterMappingNode *freeList;
-    MapTableEntry *mapTableHead;
+    int numPhysicalRegisters;
+    int numIntPhysicalRegisters; // registers below this number belong to the int pool when float registers have their own pool
+
+    // map table indexed by arch register index, holds the newest physical register mapped to each register
+    int *mapTable; // enum PhysicalRegisterName
+
+    // for each physical register, the older mapping of the same arch register it replaced (PHYS_REG_NONE if it is the oldest)
+    int *prevMapping; // enum PhysicalRegisterName
+
+    // free list for each physical register pool, the int pool is always first
+    PhysicalRegisterFreeList freeLists[MAX_PHYS_REG_POOLS];
+    int numFreeLists;
+
+    // circular buffer of checkpoints for in-flight branches, oldest first since branches commit in order
+    RenameCheckpoint *checkpoints;
+    int NC;
+    int oldestCheckpointIndex;
+    int numCheckpointsInUse;
+
+    InstructionPool *instPool; // instructions are taken from here when decoded and returned when committed or flushed
 } DecodeUnit;
 
 // decode unit methods
-void initDecodeUnit(DecodeUnit *decodeUnit, int NI, int NW);
+void initDecodeUnit(DecodeUnit *decodeUnit, int NI, int NW, int NC, int NP, int NPF, int instPoolSize);
 void teardownDecodeUnit(DecodeUnit *decodeUnit);
-void addInstructionToDecodeQueue(DecodeUnit *decodeUnit, LabelTable *labelTable, char *instStr, int instAddr);
+void addInstructionToDecodeQueue(DecodeUnit *decodeUnit, FetchBufferEntry *entry);
 void printMapTable(DecodeUnit *decodeUnit);
 void printFreeList(DecodeUnit *decodeUnit);
 void printDecodeQueue(DecodeUnit *decodeUnit);
-int numFreePhysicalRegistersAvailable(DecodeUnit *decodeUnit);
-RegisterMappingNode *getFreePhysicalRegister(DecodeUnit *decodeUnit);
-MapTableEntry *mapTableEntryForRegister(DecodeUnit *decodeUnit, ArchRegister *reg);
+int freeListIndexForArchReg(DecodeUnit *decodeUnit, ArchRegister *reg);
+int freeListIndexForPhysReg(DecodeUnit *decodeUnit, int reg); // reg = enum PhysicalRegisterName
+int getFreePhysicalRegister(DecodeUnit *decodeUnit, ArchRegister *reg); // returns PhysicalRegisterName
+void addPhysicalRegisterToFreeList(DecodeUnit *decodeUnit, int reg, int addToTail); // reg = enum PhysicalRegisterName
 int physicalRegisterMappingForReg(DecodeUnit *decodeUnit, ArchRegister *reg); //returns PhysicalRegisterName
-void addPhysicalRegisterToMapTable(DecodeUnit *decodeUnit, RegisterMappingNode *physRegNode, ArchRegister *reg);
+void addPhysicalRegisterToMapTable(DecodeUnit *decodeUnit, int physReg, ArchRegister *reg); // physReg = enum PhysicalRegisterName
 int readMapTableForReg(DecodeUnit *decodeUnit, ArchRegister *reg); // returns PhysicalRegisterName
-int numPhysicalRegisterMappingsForReg(DecodeUnit *decodeUnit, ArchRegister *reg);
-RegisterMappingNode *getFreeListTailNode(DecodeUnit *decodeUnit);
-void popOldPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, ROBStatusTable *robTable, ArchRegister *reg, int addToTail);
-void popNewPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, ArchRegister *reg, int addToTail);
-int numPhysicalRegistersNeededForInst(DecodeUnit *decodeUnit, Instruction *inst);
+void popOldPhysicalRegisterMappingForReg(DecodeUnit *decodeUnit, int committedReg, int addToTail); // committedReg = enum PhysicalRegisterName
+int isFreeRenameCheckpoint(DecodeUnit *decodeUnit);
+void takeRenameCheckpoint(DecodeUnit *decodeUnit);
+void releaseOldestRenameCheckpoint(DecodeUnit *decodeUnit);
+void restoreOldestRenameCheckpoint(DecodeUnit *decodeUnit);
+void restoreCommittedRenameState(DecodeUnit *decodeUnit);
+void countUnmappedSourceRegister(DecodeUnit *decodeUnit, ArchRegister *reg, int *numNeeded);
+void numPhysicalRegistersNeededForInst(DecodeUnit *decodeUnit, Instruction *inst, int *numNeeded);
+int physicalRegistersAvailableForInst(DecodeUnit *decodeUnit, Instruction *inst);
 int performRegisterRenamingForInst(DecodeUnit *decodeUnit, Instruction *inst);
-void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchBufferEntry **fetchBuffer, int *numInstsInBuffer, StatusTables *statusTables, RegisterFile *regFile, StallStats *stallStats, LabelTable *labelTable);
+void cycleDecodeUnit(DecodeUnit *decodeUnit, FetchUnit *fetchUnit, StatusTables *statusTables, RegisterFile *regFile, StallStats *stallStats);
+int decodeUnitIsIdle(DecodeUnit *decodeUnit, int numInstsInBuffer, StatusTables *statusTables, StallStats *stallStats, int **stallCounter);
 void flushDecodeQueue(DecodeUnit *decodeUnit);
\ No newline at end of file
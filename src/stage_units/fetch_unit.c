@@ -9,120 +9,292 @@
 #include "../branch_prediction/branch_predictor.h"
 
 // initialize the fetch unit struct
-void initFetchUnit(FetchUnit *fetchUnit, int NF) {
+void initFetchUnit(FetchUnit *fetchUnit, int NF, int fetchBufferSize, int ftqSize) {
 
     printf_DEBUG(("initializing fetch unit...\n"));
 
+    if (fetchBufferSize < 1 || ftqSize < 1) {
+        printf("error: the fetch buffer and fetch target queue need at least 1 entry, got %i and %i\n", fetchBufferSize, ftqSize);
+        exitSimulation(1);
+    }
+
     fetchUnit->NF = NF;
+
+    fetchUnit->icacheCyclesLeft = 0;
+    fetchUnit->icacheFillLineAddr = -1;
+
+    fetchUnit->ftq = calloc(ftqSize, sizeof(FetchTarget));
+    fetchUnit->ftqSize = ftqSize;
+    fetchUnit->ftqHead = 0;
+    fetchUnit->numFetchTargets = 0;
     
     // initialize instruction fetch buffer that is shared between fetch and decode units
-    fetchUnit->fetchBuffer = calloc(fetchUnit->NF, sizeof(FetchBufferEntry *));
-    fetchUnit->fetchBufferSize = fetchUnit->NF;
-    fetchUnit->numInstsInBuffer = calloc(1, sizeof(int));
+    fetchUnit->fetchBuffer = calloc(fetchBufferSize, sizeof(FetchBufferEntry));
+    fetchUnit->fetchBufferSize = fetchBufferSize;
+    fetchUnit->fetchBufferHead = 0;
+    fetchUnit->numInstsInBuffer = 0;
+
+    fetchUnit->numPredictedBlocks = 0;
+    fetchUnit->numPredictedInsts = 0;
 }
 
 // free any elements of fetch unit that are stored on the heap
 void teardownFetchUnit(FetchUnit *fetchUnit) {
 
-    for (int i = 0; i < *fetchUnit->numInstsInBuffer; i++) {
-        if (fetchUnit->fetchBuffer[i]) {
-            free(fetchUnit->fetchBuffer[i]);
-        }
+    if (fetchUnit->fetchBuffer) {
+        free(fetchUnit->fetchBuffer);
     }
 
-    free(fetchUnit->numInstsInBuffer);
+    if (fetchUnit->ftq) {
+        free(fetchUnit->ftq);
+    }
 }
 
-// doubles the size of the output buffer if necessary
-void extendFetchUnitOutputBufferIfNeeded(FetchUnit *fetchUnit) {
-
-    // only extend the buffer if it is full
-    if (*fetchUnit->numInstsInBuffer == fetchUnit->fetchBufferSize) {
-
-        // get old values
-        FetchBufferEntry **oldBuffer = fetchUnit->fetchBuffer;
-        int oldSize = fetchUnit->fetchBufferSize;
-        int newSize = oldSize * 2;
+// adds a fetched instruction to the tail of the output buffer, which must not be full
+void addInstToFetchUnitOutputBuffer(FetchUnit *fetchUnit, DecodedInstruction *decodedInst, int instAddr, int predictedNextPC, unsigned long long branchHistory) {
 
-        // reallocate array and copy contents
-        fetchUnit->fetchBufferSize = newSize;
-        fetchUnit->fetchBuffer = realloc(fetchUnit->fetchBuffer, newSize * sizeof(FetchBufferEntry *));
+    int tail = (fetchUnit->fetchBufferHead + fetchUnit->numInstsInBuffer) % fetchUnit->fetchBufferSize;
+    fetchUnit->numInstsInBuffer++;
 
-        for (int i = *fetchUnit->numInstsInBuffer; i < newSize; i++) {
-            fetchUnit->fetchBuffer[i] = NULL;
-        }
+    FetchBufferEntry *entry = &fetchUnit->fetchBuffer[tail];
+    entry->instAddr = instAddr;
+    entry->decodedInst = decodedInst;
+    entry->predictedNextPC = predictedNextPC;
+    entry->branchHistory = branchHistory;
 
-        #ifdef ENABLE_DEBUG_LOG
-        printf("extending fetch unit output buffer to %i entries\n", newSize);
-        for (int i = 0; i < newSize; i++) {
-            printf("buffer entry: %p\n", fetchUnit->fetchBuffer[i]);
-        }
-        printf("fetchBuffer: %p\n", fetchUnit->fetchBuffer);
-        #endif
-    }
+    #ifdef ENABLE_DEBUG_LOG
+    printf("added instruction: '%s' addr: '%i' to fetch buffer, numInstsInBuffer: %i\n", decodedInst->fullStr, instAddr, fetchUnit->numInstsInBuffer);
+    #endif
 }
 
-// adds a fetched instruction to the output buffer
-void addInstToFetchUnitOutputBuffer(FetchUnit *fetchUnit, char *instStr, int instAddr) {
-    extendFetchUnitOutputBufferIfNeeded(fetchUnit);
+// returns the oldest instruction in the fetch buffer, NULL if it is empty
+FetchBufferEntry *fetchBufferHead(FetchUnit *fetchUnit) {
 
-    FetchBufferEntry *entry = malloc(sizeof(FetchBufferEntry));
-    entry->instAddr = instAddr;
-    entry->instStr = instStr;
+    if (fetchUnit->numInstsInBuffer == 0) {
+        return NULL;
+    }
 
-    fetchUnit->fetchBuffer[(*fetchUnit->numInstsInBuffer)++] = entry;
+    return &fetchUnit->fetchBuffer[fetchUnit->fetchBufferHead];
+}
 
-    #ifdef ENABLE_DEBUG_LOG
-    printf("added instruction: '%s' addr: '%i' to fetch buffer, numInstsInBuffer: %i\n", instStr, instAddr, *fetchUnit->numInstsInBuffer);
-    #endif
+// removes the oldest instruction from the fetch buffer once the decode unit has taken it
+void removeFetchBufferHead(FetchUnit *fetchUnit) {
+    fetchUnit->fetchBufferHead = (fetchUnit->fetchBufferHead + 1) % fetchUnit->fetchBufferSize;
+    fetchUnit->numInstsInBuffer--;
 }
 
-// remove all entries in the fetch buffer
+// remove all entries in the fetch buffer and the fetch target queue
 void flushFetchBuffer(FetchUnit *fetchUnit) {
     
-    for (int i = 0; i < *fetchUnit->numInstsInBuffer; i++) {
-        fetchUnit->fetchBuffer[i] = NULL;
-    }
-    *fetchUnit->numInstsInBuffer = 0;
+    fetchUnit->fetchBufferHead = 0;
+    fetchUnit->numInstsInBuffer = 0;
+    fetchUnit->ftqHead = 0;
+    fetchUnit->numFetchTargets = 0;
 }
 
-// helper method to print the contents of the instruction fetch buffer
+// helper method to print the contents of the fetch target queue and the instruction fetch buffer
 void printInstructionFetchBuffer(FetchUnit *fetchUnit) {
+
+    printf("fetch target queue: size: %i, numTargets: %i, blocks: ", fetchUnit->ftqSize, fetchUnit->numFetchTargets);
+
+    for (int i = 0; i < fetchUnit->numFetchTargets; i++) {
+        FetchTarget *target = &fetchUnit->ftq[(fetchUnit->ftqHead + i) % fetchUnit->ftqSize];
+        printf("%i+%i -> %i, ", target->startAddr, target->numInsts, target->nextPC);
+    }
+
+    printf("\n");
     
-    printf("instruction fetch buffer: %p, size: %i, numInsts: %i, items: ", fetchUnit->fetchBuffer, fetchUnit->fetchBufferSize, *fetchUnit->numInstsInBuffer);
+    printf("instruction fetch buffer: size: %i, numInsts: %i, items: ", fetchUnit->fetchBufferSize, fetchUnit->numInstsInBuffer);
     
-    for (int i = 0; i < *fetchUnit->numInstsInBuffer; i++) {
-        printf("%p, ", fetchUnit->fetchBuffer[i]);
+    for (int i = 0; i < fetchUnit->numInstsInBuffer; i++) {
+        printf("%i, ", fetchUnit->fetchBuffer[(fetchUnit->fetchBufferHead + i) % fetchUnit->fetchBufferSize].instAddr);
     }
 
     printf("\n");
 }
 
-// execute fetch unit's operations during a clock cycle
-void cycleFetchUnit(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, BranchPredictor *branchPredictor) {
-
-    printf_DEBUG(("\nperforming fetch unit operations...\n"));
+// runs the branch predictor ahead of fetch, adding the blocks it predicts to the fetch target queue. it predicts up to
+// NF instructions per cycle to match the fetch bandwidth, and the PC holds the address of the next block to predict
+void predictFetchTargets(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, BranchPredictor *branchPredictor) {
 
-    // get the current value of PC
     int pcVal = readRegisterFileInt(registerFile, PHYS_REG_PC);
+    int numPredictedInsts = 0;
 
-    // get the next NF instructions
-    for (int i = 0; i < fetchUnit->NF; i++) {
+    while (numPredictedInsts < fetchUnit->NF && fetchUnit->numFetchTargets < fetchUnit->ftqSize) {
 
-        // get the instruction from the instruction cache
-        char *instStr = readInstructionCache(instCache, pcVal);
-        if (!instStr) {
+        // get the pre-decoded instruction from the instruction cache
+        DecodedInstruction *decodedInst = readInstructionCache(instCache, pcVal);
+        if (!decodedInst) {
             printf_DEBUG(("could not get instruction from cache\n"));
             break;
         }
 
-        // write the instruction to the buffer
-        addInstToFetchUnitOutputBuffer(fetchUnit, instStr, pcVal);
+        FetchTarget *target = &fetchUnit->ftq[(fetchUnit->ftqHead + fetchUnit->numFetchTargets) % fetchUnit->ftqSize];
+        fetchUnit->numFetchTargets++;
+        fetchUnit->numPredictedBlocks++;
+
+        target->startAddr = pcVal;
+        target->numInsts = 0;
+        target->branchHistory = branchPredictor->speculativeHistory;
+
+        // extend the block until a branch or jump, which is the only instruction whose next PC has to be predicted
+        while (decodedInst && numPredictedInsts < fetchUnit->NF) {
+            target->numInsts++;
+            numPredictedInsts++;
+
+            if (instTypeIsBranchOrJump(decodedInst->type)) {
+
+                // jumps are always taken, so only their target is predicted
+                if (decodedInst->type == BNE) {
+                    pcVal = predictNextPC(branchPredictor, pcVal);
+
+                    // later predictions see the predicted direction of the branch
+                    speculativelyUpdateBranchHistory(branchPredictor, pcVal != decodedInst->addr + 4);
+                } else {
+                    pcVal = predictJumpTarget(branchPredictor, decodedInst);
+                }
+
+                break;
+            }
+
+            pcVal += 4;
+            decodedInst = readInstructionCache(instCache, pcVal);
+        }
+
+        target->nextPC = pcVal;
+        fetchUnit->numPredictedInsts += target->numInsts;
 
-        // pcVal += 4;
-        pcVal = predictNextPC(branchPredictor, pcVal);
+        #ifdef ENABLE_DEBUG_LOG
+        printf("predicted fetch block starting at: %i with %i instructions, next pc: %i\n", target->startAddr, target->numInsts, target->nextPC);
+        #endif
     }
-    
+
     // update the new value of PC in the register file
     writeRegisterFileInt(registerFile, PHYS_REG_PC, pcVal);
- }
\ No newline at end of file
+}
+
+// execute fetch unit's operations during a clock cycle
+void cycleFetchUnit(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, DataCache *dataCache, BranchPredictor *branchPredictor, 
+    StallStats *stallStats, int cycle) {
+
+    printf_DEBUG(("\nperforming fetch unit operations...\n"));
+
+    predictFetchTargets(fetchUnit, registerFile, instCache, branchPredictor);
+
+    // wait for a line that missed in the instruction cache, the predictor keeps running ahead meanwhile
+    int lineWasFilled = 0;
+    if (fetchUnit->icacheCyclesLeft > 0) {
+        if (--fetchUnit->icacheCyclesLeft > 0) {
+            printf_DEBUG(("fetch unit is waiting for the instruction cache\n"));
+            stallStats->icacheMissStalls++;
+            return;
+        }
+
+        lineWasFilled = 1;
+    }
+
+    if (fetchUnit->numFetchTargets == 0) {
+        return;
+    }
+
+    if (fetchUnit->numInstsInBuffer == fetchUnit->fetchBufferSize) {
+        printf_DEBUG(("fetch buffer is full\n"));
+        stallStats->fullFetchBufferStalls++;
+        return;
+    }
+
+    // every instruction fetched in a cycle comes from the same line. the line that was just filled is read without another
+    // access unless a flush moved fetch elsewhere while it was being filled
+    CacheModel *l1Cache = instCache->l1Cache;
+    int lineAddr = cacheModelLineAddress(l1Cache, fetchUnit->ftq[fetchUnit->ftqHead].startAddr);
+
+    if (!lineWasFilled || lineAddr != fetchUnit->icacheFillLineAddr) {
+        int latency = accessL1InstCache(instCache, dataCache, fetchUnit->ftq[fetchUnit->ftqHead].startAddr, cycle);
+
+        if (latency > 1) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("instruction fetch missed in the instruction cache for line: %i, waiting %i cycles\n", lineAddr, latency - 1);
+            #endif
+
+            fetchUnit->icacheCyclesLeft = latency - 1;
+            fetchUnit->icacheFillLineAddr = lineAddr;
+            stallStats->icacheMissStalls++;
+            return;
+        }
+    }
+
+    // fetch the next NF instructions of the predicted blocks in the line, continuing past taken branches
+    for (int i = 0; i < fetchUnit->NF && fetchUnit->numFetchTargets > 0; i++) {
+
+        if (fetchUnit->numInstsInBuffer == fetchUnit->fetchBufferSize) {
+            printf_DEBUG(("fetch buffer is full\n"));
+            stallStats->fullFetchBufferStalls++;
+            break;
+        }
+
+        FetchTarget *target = &fetchUnit->ftq[fetchUnit->ftqHead];
+        int pcVal = target->startAddr;
+
+        if (cacheModelLineAddress(l1Cache, pcVal) != lineAddr) {
+            break;
+        }
+
+        // only the last instruction of a block can continue anywhere but the next address
+        int nextPCVal = target->numInsts == 1 ? target->nextPC : pcVal + 4;
+
+        // write the instruction to the buffer along with the prediction so it can be checked when the instruction commits
+        addInstToFetchUnitOutputBuffer(fetchUnit, readInstructionCache(instCache, pcVal), pcVal, nextPCVal, target->branchHistory);
+
+        target->startAddr += 4;
+        target->numInsts--;
+        if (target->numInsts == 0) {
+            fetchUnit->ftqHead = (fetchUnit->ftqHead + 1) % fetchUnit->ftqSize;
+            fetchUnit->numFetchTargets--;
+        }
+    }
+}
+
+// returns 1 if the fetch unit holds no predicted blocks or fetched instructions
+int fetchUnitIsEmpty(FetchUnit *fetchUnit) {
+    return fetchUnit->numFetchTargets == 0 && fetchUnit->numInstsInBuffer == 0;
+}
+
+// returns 1 if the fetch unit cannot fetch or predict any instruction in the next cycle
+int fetchUnitIsIdle(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache) {
+
+    // waiting for the instruction cache only counts down until the cycle in which the line is filled
+    if (fetchUnit->icacheCyclesLeft == 1) {
+        return 0;
+    }
+
+    if (fetchUnit->icacheCyclesLeft == 0 && fetchUnit->numFetchTargets > 0 && fetchUnit->numInstsInBuffer < fetchUnit->fetchBufferSize) {
+        return 0;
+    }
+
+    return fetchUnit->numFetchTargets == fetchUnit->ftqSize || !readInstructionCache(instCache, readRegisterFileInt(registerFile, PHYS_REG_PC));
+}
+
+// returns the number of cycles until a line that missed in the instruction cache is filled, -1 if fetch is not waiting for one
+int cyclesUntilFetchUnitLineReturns(FetchUnit *fetchUnit) {
+    return fetchUnit->icacheCyclesLeft > 0 ? fetchUnit->icacheCyclesLeft : -1;
+}
+
+// moves an idle fetch unit forward by a number of cycles, the same as cycling it that many times
+void advanceFetchUnit(FetchUnit *fetchUnit, int numCycles, StallStats *stallStats) {
+
+    if (fetchUnit->icacheCyclesLeft > 0) {
+        fetchUnit->icacheCyclesLeft -= numCycles;
+        stallStats->icacheMissStalls += numCycles;
+    } else if (fetchUnit->numFetchTargets > 0) {
+        stallStats->fullFetchBufferStalls += numCycles;
+    }
+}
+
+// prints the number of blocks predicted ahead of fetch and their average length
+void printFetchUnitStats(FetchUnit *fetchUnit) {
+    printf("\nfetch unit statistics:\n");
+    printf("\tpredicted fetch blocks: %i\n", fetchUnit->numPredictedBlocks);
+    if (fetchUnit->numPredictedBlocks > 0) {
+        printf("\taverage instructions per block: %.2f\n", (double) fetchUnit->numPredictedInsts / fetchUnit->numPredictedBlocks);
+    }
+}
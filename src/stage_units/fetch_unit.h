@@ -4,20 +4,50 @@ typedef struct RegisterFile RegisterFile;
 typedef struct InstCache InstCache;
 typedef struct BranchPredictor BranchPredictor;
 typedef struct FetchBufferEntry FetchBufferEntry;
+typedef struct FetchTarget FetchTarget;
+typedef struct DecodedInstruction DecodedInstruction;
+typedef struct StallStats StallStats;
+typedef struct DataCache DataCache;
 
-// struct representing a fetch unit
+// struct representing a fetch unit, decoupled from the branch predictor by the fetch target queue
 typedef struct FetchUnit {
-    FetchBufferEntry **fetchBuffer;
-    int *numInstsInBuffer;
+
+    // circular queue of blocks predicted by the branch predictor that have not been fully fetched
+    FetchTarget *ftq;
+    int ftqSize;
+    int ftqHead;
+    int numFetchTargets;
+
+    // circular queue of fetched instructions shared with the decode unit, entries are stored by value so that fetching
+    // never allocates
+    FetchBufferEntry *fetchBuffer;
     int fetchBufferSize;
+    int fetchBufferHead;
+    int numInstsInBuffer;
+
     int NF;
+
+    // line that missed in the L1 instruction cache and the cycles until it is filled, fetch waits for it
+    int icacheCyclesLeft;
+    int icacheFillLineAddr;
+
+    int numPredictedBlocks;
+    int numPredictedInsts;
 } FetchUnit;
 
 // fetch unit methods
-void initFetchUnit(FetchUnit *fetchUnit, int NF);
+void initFetchUnit(FetchUnit *fetchUnit, int NF, int fetchBufferSize, int ftqSize);
 void teardownFetchUnit(FetchUnit *fetchUnit);
-void addInstToFetchUnitOutputBuffer(FetchUnit *fetchUnit, char *instStr, int instAddr);
-void extendFetchUnitOutputBufferIfNeeded(FetchUnit *fetchUnit);
-void cycleFetchUnit(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, BranchPredictor *branchPredictor);
+void addInstToFetchUnitOutputBuffer(FetchUnit *fetchUnit, DecodedInstruction *decodedInst, int instAddr, int predictedNextPC, unsigned long long branchHistory);
+FetchBufferEntry *fetchBufferHead(FetchUnit *fetchUnit);
+void removeFetchBufferHead(FetchUnit *fetchUnit);
+void predictFetchTargets(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, BranchPredictor *branchPredictor);
+void cycleFetchUnit(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache, DataCache *dataCache, BranchPredictor *branchPredictor, 
+    StallStats *stallStats, int cycle);
+int fetchUnitIsEmpty(FetchUnit *fetchUnit);
+int fetchUnitIsIdle(FetchUnit *fetchUnit, RegisterFile *registerFile, InstCache *instCache);
+int cyclesUntilFetchUnitLineReturns(FetchUnit *fetchUnit);
+void advanceFetchUnit(FetchUnit *fetchUnit, int numCycles, StallStats *stallStats);
 void flushFetchBuffer(FetchUnit *fetchUnit);
-void printInstructionFetchBuffer(FetchUnit *fetchUnit);
\ No newline at end of file
+void printInstructionFetchBuffer(FetchUnit *fetchUnit);
+void printFetchUnitStats(FetchUnit *fetchUnit);
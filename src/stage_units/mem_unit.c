@@ -9,134 +9,330 @@
 #include "mem_unit.h"
 
 // initialize memory unit struct
-void initMemoryUnit(MemoryUnit *memUnit) {
+void initMemoryUnit(MemoryUnit *memUnit, Params *params) {
     memUnit->currResult = NULL;
     memUnit->isStalledFromWB = 0;
-    memUnit->isStalledFromStore = 0;
-    memUnit->forwardedData = 0;
-    memUnit->forwardedAddr = -1;
+    memUnit->cacheCyclesLeft = 0;
+    memUnit->isStalledFromMSHRs = 0;
+
+    memUnit->numMSHRs = params->numMSHRs;
+    memUnit->mshrs = calloc(memUnit->numMSHRs, sizeof(MSHR));
+
+    memUnit->numMissedLoadSlots = params->numLoadStations;
+    memUnit->missedLoads = calloc(memUnit->numMissedLoadSlots, sizeof(MissedLoad));
 }
 
 // free any elements of the memory unit that are stored on the heap
 void teardownMemoryUnit(MemoryUnit *memUnit) {
-    // no elements
+    if (memUnit->mshrs) {
+        free(memUnit->mshrs);
+    }
+    if (memUnit->missedLoads) {
+        free(memUnit->missedLoads);
+    }
 }
 
 // flushes any contents of the memory unit
 void flushMemUnit(MemoryUnit *memUnit) {
     memUnit->currResult = NULL;
     memUnit->isStalledFromWB = 0;
-    memUnit->isStalledFromStore = 0;
-    memUnit->forwardedData = 0;
-    memUnit->forwardedAddr = -1;
+    memUnit->cacheCyclesLeft = 0;
+    memUnit->isStalledFromMSHRs = 0;
+
+    // line fills that are in flight are dropped along with the loads waiting for them
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        memUnit->mshrs[i].busy = 0;
+    }
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        memUnit->missedLoads[i].busy = 0;
+    }
 }
 
-// returns the result from the memory unit if it is not stalled while waiting for stores to clear
+// returns the result from the memory unit if it is not stalled while waiting for the data cache or for a free MSHR
 LSFUResult *getMemoryUnitCurrentResult(MemoryUnit *memUnit) {
     
-    // if memory unit was stalled because a store is writing to the same address that the load is reading from
-    if (memUnit->isStalledFromStore) {
+    if (memoryUnitIsHoldingLoad(memUnit)) {
         return NULL;
     } else {
         return memUnit->currResult;
     }
 }
 
-// receive forwarded data from WB unit when a store enters writeback stage
-void forwardDataToMemoryUnit(MemoryUnit *memUnit, float value, int addr) {
+// stalls every load/store functional unit
+void stallLSFunctionalUnits(LSFunctionalUnit *lsFUs, int numLSFUs) {
+    for (int i = 0; i < numLSFUs; i++) {
+        lsFUs[i].isStalled = 1;
+    }
+}
+
+// stalls the load/store functional units holding a result that is not the one in the memory unit, so they keep it until the memory unit takes it
+void updateLSFunctionalUnitStalls(MemoryUnit *memUnit, LSFunctionalUnit *lsFUs, int numLSFUs) {
+    for (int i = 0; i < numLSFUs; i++) {
+        LSFUResult *result = getCurrentLSFunctionalUnitResult(&lsFUs[i]);
+        lsFUs[i].isStalled = result && result != memUnit->currResult;
+    }
+}
+
+// returns the completed load/store functional unit result that is closest to the head of the ROB, NULL if there are none
+LSFUResult *oldestLSFunctionalUnitResult(LSFunctionalUnit *lsFUs, int numLSFUs, ROBStatusTable *robTable) {
+
+    LSFUResult *oldestResult = NULL;
+
+    for (int i = 0; i < numLSFUs; i++) {
+        LSFUResult *result = getCurrentLSFunctionalUnitResult(&lsFUs[i]);
+
+        if (result && (!oldestResult || indexDistanceToROBHead(robTable, result->destROB) < indexDistanceToROBHead(robTable, oldestResult->destROB))) {
+            oldestResult = result;
+        }
+    }
+
+    return oldestResult;
+}
+
+// returns the index of the MSHR that is filling a given line, -1 if the line is not being filled
+int mshrIndexForLine(MemoryUnit *memUnit, int lineAddr) {
+
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        if (memUnit->mshrs[i].busy && memUnit->mshrs[i].lineAddr == lineAddr) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// moves a load that missed in the data cache out of the memory unit to wait for its line, allocating a MSHR if the line is not
+// already being filled. returns 0 if there was no free MSHR, in which case the data cache is not accessed
+int addMissedLoadToMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFUResult *lsResult, int mshrIndex, int cycle) {
+
+    int slot = -1;
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        if (!memUnit->missedLoads[i].busy) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == -1) {
+        return 0;
+    }
+
+    // a secondary miss waits for the fill that is already in flight
+    if (mshrIndex != -1) {
+        dataCache->l1Cache->numMisses++;
+        recordCacheModelLoad(dataCache->l1Cache, memUnit->mshrs[mshrIndex].cyclesLeft + 1);
+
+    } else {
+        for (int i = 0; i < memUnit->numMSHRs; i++) {
+            if (!memUnit->mshrs[i].busy) {
+                mshrIndex = i;
+                break;
+            }
+        }
+
+        if (mshrIndex == -1) {
+            return 0;
+        }
+
+        MSHR *mshr = &memUnit->mshrs[mshrIndex];
+        mshr->busy = 1;
+        mshr->lineAddr = cacheModelLineAddress(dataCache->l1Cache, lsResult->resultAddr);
+        mshr->cyclesLeft = accessL1DataCache(dataCache, lsResult->resultAddr, cycle, 1) - 1;
+    }
+
     #ifdef ENABLE_DEBUG_LOG
-    printf("memory unit received forwarded data: %f from address: %i\n", value, addr);
+    printf("load for ROB: %i missed in the data cache, waiting on MSHR: %i for %i cycles\n", lsResult->destROB, mshrIndex, memUnit->mshrs[mshrIndex].cyclesLeft);
     #endif
 
-    memUnit->forwardedData = value;
-    memUnit->forwardedAddr = addr;
+    MissedLoad *missedLoad = &memUnit->missedLoads[slot];
+    missedLoad->busy = 1;
+    missedLoad->destROB = lsResult->destROB;
+    missedLoad->resultAddr = lsResult->resultAddr;
+    missedLoad->loadValue = 0;
+    missedLoad->mshrIndex = mshrIndex;
+
+    return 1;
+}
+
+// frees the missed load for a given ROB once it has been written back, returns 0 if the ROB does not belong to a missed load
+int releaseMissedLoadForROB(MemoryUnit *memUnit, int robIndex) {
+
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        MissedLoad *missedLoad = &memUnit->missedLoads[i];
+
+        if (missedLoad->busy && missedLoad->mshrIndex == -1 && missedLoad->destROB == robIndex) {
+            missedLoad->busy = 0;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// counts down the line fills in flight, loading the values of the loads waiting on lines that were filled
+void cycleMSHRs(MemoryUnit *memUnit, DataCache *dataCache, StatusTables *statusTables) {
+
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        MSHR *mshr = &memUnit->mshrs[i];
+
+        if (!mshr->busy || --mshr->cyclesLeft > 0) {
+            continue;
+        }
+
+        for (int j = 0; j < memUnit->numMissedLoadSlots; j++) {
+            MissedLoad *missedLoad = &memUnit->missedLoads[j];
+
+            if (missedLoad->busy && missedLoad->mshrIndex == i) {
+                missedLoad->loadValue = readFloatFromDataCache(dataCache, missedLoad->resultAddr);
+                missedLoad->mshrIndex = -1;
+
+                #ifdef ENABLE_DEBUG_LOG
+                printf("MSHR: %i filled, load for ROB: %i loaded value: %f from address: %i\n", i, missedLoad->destROB, missedLoad->loadValue, missedLoad->resultAddr);
+                #endif
+
+                // forward result to any waiting functional units
+                sendFloatUpdateToResStationStatusTable(statusTables->resStationTable, missedLoad->destROB, missedLoad->loadValue, 0);
+            }
+        }
+
+        mshr->busy = 0;
+    }
+}
+
+// completes a load once its value is known, letting the load/store functional units continue
+void finishLoadInMemoryUnit(MemoryUnit *memUnit, LSFUResult *lsResult, LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables) {
+
+    // unstall load/store functional units and memory unit as execution was able to proceed
+    updateLSFunctionalUnitStalls(memUnit, lsFUs, numLSFUs);
+    memUnit->isStalledFromMSHRs = 0;
+
+    // forward result to any waiting functional units
+    sendFloatUpdateToResStationStatusTable(statusTables->resStationTable, lsResult->destROB, lsResult->loadValue, 0);
+}
+
+// shows the prefetcher the address of a load once it leaves the memory unit or starts waiting for the data cache, after
+// its own access so that a prefetch never takes the place of the load's miss. loads retried after full MSHRs are only seen once
+void prefetchForLoadInMemoryUnit(DataCache *dataCache, ROBStatusTable *robTable, LSFUResult *lsResult, int cycle) {
+    Instruction *inst = robTable->entries[lsResult->destROB].inst;
+    prefetchForDataCacheLoad(dataCache, inst->addr, lsResult->resultAddr, cycle);
 }
 
 // perform memory unit operations over a cycle
-void cycleMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFunctionalUnit *lsFU, StatusTables *statusTables) {
+void cycleMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables, StallStats *stallStats, int cycle) {
     printf_DEBUG(("\nperforming memory unit operations...\n"));
 
     ROBStatusTable *robTable = statusTables->robTable;
 
+    // line fills keep going no matter what happens to the rest of the memory unit
+    cycleMSHRs(memUnit, dataCache, statusTables);
+
     // check if the writeback unit did not take in result and place it on CDB
     if (memUnit->isStalledFromWB) {
         printf_DEBUG(("\tmemory unit is stalled due to WB unit not placing data on the CDB"));
+        stallLSFunctionalUnits(lsFUs, numLSFUs);
+        return;
+    }
 
-        clearMemoryUnitForwardedData(memUnit);
-        lsFU->isStalled = 1;
+    // check if the current load is still waiting for the data cache
+    if (memUnit->cacheCyclesLeft > 0) {
+        stallLSFunctionalUnits(lsFUs, numLSFUs);
+
+        if (--memUnit->cacheCyclesLeft == 0) {
+            LSFUResult *lsResult = memUnit->currResult;
+            lsResult->loadValue = readFloatFromDataCache(dataCache, lsResult->resultAddr);
+
+            #ifdef ENABLE_DEBUG_LOG
+            printf("memory unit loaded value: %f from the data cache at address: %i!\n", lsResult->loadValue, lsResult->resultAddr);
+            #endif
+
+            finishLoadInMemoryUnit(memUnit, lsResult, lsFUs, numLSFUs, statusTables);
+        } else {
+            printf_DEBUG(("memory unit is waiting for the data cache\n"));
+        }
         return;
-    } else {
-        lsFU->isStalled = 0;
     }
 
     LSFUResult *lsResult = NULL;
 
-    // check if stalled from a store in a previous cycle
-    if (memUnit->isStalledFromStore) {
-        printf_DEBUG(("memory unit is stalled from store in previous cycle, trying current result again\n"));
+    // check if stalled from full MSHRs in a previous cycle
+    if (memUnit->isStalledFromMSHRs) {
+        printf_DEBUG(("memory unit is stalled from full MSHRs in previous cycle, trying current result again\n"));
 
         lsResult = memUnit->currResult;
-        lsFU->isStalled = 1;
+        stallLSFunctionalUnits(lsFUs, numLSFUs);
     
-    // if not get the result from the load/store functional unit
+    // if not get the oldest result from the load/store functional units, the others wait for a later cycle
     } else {
-        printf_DEBUG(("memory unit is not stalled from previous store, getting load/store functional unit results\n"));
+        printf_DEBUG(("memory unit is not stalled from full MSHRs, getting load/store functional unit results\n"));
 
-        lsResult = getCurrentLSFunctionalUnitResult(lsFU);
+        lsResult = oldestLSFunctionalUnitResult(lsFUs, numLSFUs, robTable);
         memUnit->currResult = lsResult;
-        lsFU->isStalled = 0;
+        updateLSFunctionalUnitStalls(memUnit, lsFUs, numLSFUs);
     }
 
     // do not perform operations if there is no result
     if (!lsResult) {
         printf_DEBUG(("there are no load/store results available, returning...\n"));
-        clearMemoryUnitForwardedData(memUnit);
         return;
     }
 
+    LoadStoreQueue *lsq = statusTables->loadStoreQueue;
+
     // check if a load instruction is currently in the memory unit
     if (lsResult->fuType == FU_TYPE_LOAD) {
 
-        // need to check if there is any stores ahead of the load that will write to the given address
+        // the youngest older store that writes to the address provides the value without going to the data cache. older stores
+        // whose address is still unknown are passed, the store queue catches the violation if one of them turns out to match
+        LoadStoreQueueEntry *forwardingStore = forwardingStoreForLoad(lsq, lsResult->destROB, lsResult->resultAddr);
+        setLoadAddressInLoadStoreQueue(lsq, lsResult->destROB, lsResult->resultAddr, forwardingStore);
 
-        // check if data was forwarded from the WB stage 
-        if (memUnit->forwardedAddr == lsResult->resultAddr) {
-            lsResult->loadValue = memUnit->forwardedData;
+        if (forwardingStore) {
+            lsResult->loadValue = forwardingStore->value;
+            lsq->numForwardedLoads++;
 
             #ifdef ENABLE_DEBUG_LOG
-            printf("load with addr: %i received forwarded float: %f", memUnit->forwardedAddr, memUnit->forwardedData);
+            printf("load for ROB: %i received forwarded float: %f from store for ROB: %i at address: %i\n", lsResult->destROB, lsResult->loadValue, forwardingStore->robIndex, lsResult->resultAddr);
             #endif 
 
-        // no data was forwarded, proceed as normal
+        // no older store writes to the address, the value comes from the data cache
         } else {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("result destROB: %i, robTableHeadIndex: %i\n", lsResult->destROB, robTable->headEntryIndex);
-            #endif
+            
+            // a load that misses waits for its line outside of the memory unit, which takes the next load or store in the following cycle
+            CacheModel *l1Cache = dataCache->l1Cache;
+            int mshrIndex = mshrIndexForLine(memUnit, cacheModelLineAddress(l1Cache, lsResult->resultAddr));
 
-            if (lsResult->destROB != robTable->headEntryIndex) {
+            if (mshrIndex != -1 || (dataCacheMissTakesMultipleCycles(dataCache) && !cacheModelContainsAddress(l1Cache, lsResult->resultAddr, CACHE_ADDR_SPACE_DATA))) {
 
-                for (int i = robTable->headEntryIndex; i != lsResult->destROB; i = (i + 1) % robTable->NR) {
-                    
-                    #ifdef ENABLE_DEBUG_LOG
-                    printf("checking ROB: %i for store conflict\n", i);
-                    #endif
+                if (!addMissedLoadToMemoryUnit(memUnit, dataCache, lsResult, mshrIndex, cycle)) {
+                    printf_DEBUG(("load missed in the data cache but every MSHR is in use, stalling memory unit and load/store functional units\n"));
 
-                    ROBStatusTableEntry *entry = robTable->entries[i];
-                    
-                    // check if there is a store between the load ROB and the head ROB that writes to the address 
-                    if (entry->busy && entry->fuType == FU_TYPE_STORE && entry->addr == lsResult->resultAddr) {
-                        printf_DEBUG(("found store which writes to same address as the current load, stalling memory unit and load/store functional unit\n"));
+                    memUnit->isStalledFromMSHRs = 1;
+                    stallStats->fullMSHRStalls++;
+                    stallLSFunctionalUnits(lsFUs, numLSFUs);
+                    return;
+                }
 
-                        memUnit->isStalledFromStore = 1;
-                        lsFU->isStalled = 1;
+                // the load functional unit holding the load can move on, it no longer occupies the memory unit
+                prefetchForLoadInMemoryUnit(dataCache, robTable, lsResult, cycle);
+                memUnit->isStalledFromMSHRs = 0;
+                updateLSFunctionalUnitStalls(memUnit, lsFUs, numLSFUs);
+                memUnit->currResult = NULL;
+                return;
+            }
 
-                        clearMemoryUnitForwardedData(memUnit);
-                        return;
-                    }
-                }
+            // can load value from memory at the calculated address once the data cache returns it
+            memUnit->cacheCyclesLeft = accessL1DataCache(dataCache, lsResult->resultAddr, cycle, 1) - 1;
+            if (memUnit->cacheCyclesLeft > 0) {
+                #ifdef ENABLE_DEBUG_LOG
+                printf("memory unit waiting %i more cycles for the data cache to return address: %i\n", memUnit->cacheCyclesLeft, lsResult->resultAddr);
+                #endif
+
+                prefetchForLoadInMemoryUnit(dataCache, robTable, lsResult, cycle);
+                stallLSFunctionalUnits(lsFUs, numLSFUs);
+                memUnit->isStalledFromMSHRs = 0;
+                return;
             }
-            
-            // no conflicts were found, can load value from memory at the calculated address
+
             lsResult->loadValue = readFloatFromDataCache(dataCache, lsResult->resultAddr);
 
             #ifdef ENABLE_DEBUG_LOG
@@ -144,29 +340,107 @@ void cycleMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFunctionalUnit
             #endif
         }
 
-        // unstall load/store functional unit and memory unit as execution was able to proceed
-        lsFU->isStalled = 0;
-        memUnit->isStalledFromStore = 0;
-
-        // forward result to any waiting functional units
-        sendFloatUpdateToResStationStatusTable(statusTables->resStationTable, lsResult->destROB, lsResult->loadValue, 0);
+        prefetchForLoadInMemoryUnit(dataCache, robTable, lsResult, cycle);
+        finishLoadInMemoryUnit(memUnit, lsResult, lsFUs, numLSFUs, statusTables);
 
     } else if (lsResult->fuType == FU_TYPE_STORE) {
 
-        // stores do not do anything in the memory unit, they just get passed on to the WB unit
+        // stores are passed on to the WB unit, and their address and value become visible to younger loads through the store queue,
+        // which also marks younger loads to the same address that already read a stale value
+        setStoreAddressInLoadStoreQueue(lsq, lsResult->destROB, lsResult->resultAddr, lsResult->storeValue);
 
     } else {
         #ifdef ENABLE_DEBUG_LOG
         printf("error: invalid functional unit (neither load or store) from LSFUResult in memory unit, this shouldn't happen\n");
         #endif
     }
+}
+
+// returns 1 if the memory unit will not do anything in the next cycle, which is the case when it has no result to
+// process or it is holding a load that waits for a free MSHR
+int memoryUnitIsIdle(MemoryUnit *memUnit, LSFunctionalUnit *lsFUs, int numLSFUs) {
+
+    if (memUnit->isStalledFromWB) {
+        return 0;
+    }
 
-    clearMemoryUnitForwardedData(memUnit);
+    // loads whose lines were filled are waiting to be written back
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        if (memUnit->missedLoads[i].busy && memUnit->missedLoads[i].mshrIndex == -1) {
+            return 0;
+        }
+    }
+
+    // waiting for the data cache only counts down until the cycle in which the load completes
+    if (memUnit->isStalledFromMSHRs || memUnit->cacheCyclesLeft > 1) {
+        return 1;
+    } else if (memUnit->cacheCyclesLeft == 1) {
+        return 0;
+    }
+
+    for (int i = 0; i < numLSFUs; i++) {
+        if (getCurrentLSFunctionalUnitResult(&lsFUs[i])) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// returns 1 if the memory unit is holding on to a load and can't take a result from the load/store functional units
+int memoryUnitIsHoldingLoad(MemoryUnit *memUnit) {
+    return memUnit->isStalledFromMSHRs || memUnit->cacheCyclesLeft > 0;
+}
+
+// returns the number of cycles until the data cache returns a value for the current load or a line fill completes, -1 if nothing is waiting
+int cyclesUntilMemoryUnitLoadCompletes(MemoryUnit *memUnit) {
+
+    int minCycles = memUnit->cacheCyclesLeft > 0 ? memUnit->cacheCyclesLeft : -1;
+
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        MSHR *mshr = &memUnit->mshrs[i];
+        if (mshr->busy && (minCycles == -1 || mshr->cyclesLeft < minCycles)) {
+            minCycles = mshr->cyclesLeft;
+        }
+    }
+
+    return minCycles;
+}
+
+// moves loads waiting for the data cache forward by a number of cycles in which nothing else happens
+void advanceMemoryUnit(MemoryUnit *memUnit, int numCycles, StallStats *stallStats) {
+    if (memUnit->cacheCyclesLeft > 0) {
+        memUnit->cacheCyclesLeft -= numCycles;
+    }
+
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        if (memUnit->mshrs[i].busy) {
+            memUnit->mshrs[i].cyclesLeft -= numCycles;
+        }
+    }
+
+    // a load stalled on full MSHRs retries every cycle
+    if (memUnit->isStalledFromMSHRs) {
+        stallStats->fullMSHRStalls += numCycles;
+    }
 }
 
 // prints the current contents of the memory unit
 void printMemoryUnit(MemoryUnit *memUnit) {
-    printf("Memory unit: isStalledFromWB: %i, isStalledFromStore: %i\n", memUnit->isStalledFromWB, memUnit->isStalledFromStore);
+    printf("Memory unit: isStalledFromWB: %i, isStalledFromMSHRs: %i, cacheCyclesLeft: %i\n", memUnit->isStalledFromWB, memUnit->isStalledFromMSHRs, memUnit->cacheCyclesLeft);
+
+    for (int i = 0; i < memUnit->numMSHRs; i++) {
+        MSHR *mshr = &memUnit->mshrs[i];
+        if (mshr->busy) {
+            printf("\tMSHR: %i, lineAddr: %i, cyclesLeft: %i\n", i, mshr->lineAddr, mshr->cyclesLeft);
+        }
+    }
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        MissedLoad *missedLoad = &memUnit->missedLoads[i];
+        if (missedLoad->busy) {
+            printf("\tmissed load: destROB: %i, resultAddr: %i, mshrIndex: %i, loadValue: %f\n", missedLoad->destROB, missedLoad->resultAddr, missedLoad->mshrIndex, missedLoad->loadValue);
+        }
+    }
     
     LSFUResult *result = memUnit->currResult;
     if (memUnit->currResult) {
@@ -175,10 +449,4 @@ void printMemoryUnit(MemoryUnit *memUnit) {
     } else {
         printf("\tcurrResult: NULL\n");
     }
-}
-
-// clears the forwardeded data
-void clearMemoryUnitForwardedData(MemoryUnit *memUnit) {
-    memUnit->forwardedData = 0;
-    memUnit->forwardedAddr = -1;
 }
\ No newline at end of file
@@ -4,24 +4,59 @@ typedef struct DataCache DataCache;
 typedef struct StatusTables StatusTables;
 typedef struct LSFUResult LSFUResult;
 typedef struct LSFunctionalUnit LSFunctionalUnit;
+typedef struct ROBStatusTable ROBStatusTable;
+typedef struct Params Params;
+typedef struct StallStats StallStats;
+
+// struct representing a miss status holding register, which tracks a data cache line fill that is in flight
+typedef struct MSHR {
+    int busy;
+    int lineAddr;
+    int cyclesLeft; // cycles until the line is filled
+} MSHR;
+
+// struct representing a load that missed in the data cache, it waits here for its line so the memory unit can take other loads and stores
+typedef struct MissedLoad {
+    int busy;
+    int destROB;
+    int resultAddr;
+    float loadValue;
+    int mshrIndex; // MSHR the load waits on, -1 once the value has been loaded and the load can be written back
+} MissedLoad;
 
 // struct representing the memory unit
 typedef struct MemoryUnit {
 
     LSFUResult *currResult;
     int isStalledFromWB;
-    int isStalledFromStore;
-    float forwardedData;
-    int forwardedAddr;
+    int cacheCyclesLeft; // cycles until the data cache returns the value of the current load, 0 if it is not waiting
+    int isStalledFromMSHRs; // the current load missed in the data cache while every MSHR was in use
+
+    MSHR *mshrs;
+    int numMSHRs;
+
+    // a load keeps its reservation station until it is written back, so there can't be more missed loads than load stations
+    MissedLoad *missedLoads;
+    int numMissedLoadSlots;
 
 } MemoryUnit;
 
 // memory unit methods
-void initMemoryUnit(MemoryUnit *memUnit);
+void initMemoryUnit(MemoryUnit *memUnit, Params *params);
 void teardownMemoryUnit(MemoryUnit *memUnit);
-void cycleMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFunctionalUnit *lsFU, StatusTables *statusTables);
+void stallLSFunctionalUnits(LSFunctionalUnit *lsFUs, int numLSFUs);
+void updateLSFunctionalUnitStalls(MemoryUnit *memUnit, LSFunctionalUnit *lsFUs, int numLSFUs);
+LSFUResult *oldestLSFunctionalUnitResult(LSFunctionalUnit *lsFUs, int numLSFUs, ROBStatusTable *robTable);
+int mshrIndexForLine(MemoryUnit *memUnit, int lineAddr);
+int addMissedLoadToMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFUResult *lsResult, int mshrIndex, int cycle);
+int releaseMissedLoadForROB(MemoryUnit *memUnit, int robIndex);
+void cycleMSHRs(MemoryUnit *memUnit, DataCache *dataCache, StatusTables *statusTables);
+void cycleMemoryUnit(MemoryUnit *memUnit, DataCache *dataCache, LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables, StallStats *stallStats, int cycle);
 void flushMemUnit(MemoryUnit *memUnit);
 void printMemoryUnit(MemoryUnit *memUnit);
 LSFUResult *getMemoryUnitCurrentResult(MemoryUnit *memUnit);
-void forwardDataToMemoryUnit(MemoryUnit *memUnit, float value, int destROB);
-void clearMemoryUnitForwardedData(MemoryUnit *memUnit);
\ No newline at end of file
+void finishLoadInMemoryUnit(MemoryUnit *memUnit, LSFUResult *lsResult, LSFunctionalUnit *lsFUs, int numLSFUs, StatusTables *statusTables);
+int memoryUnitIsIdle(MemoryUnit *memUnit, LSFunctionalUnit *lsFUs, int numLSFUs);
+int memoryUnitIsHoldingLoad(MemoryUnit *memUnit);
+int cyclesUntilMemoryUnitLoadCompletes(MemoryUnit *memUnit);
+void advanceMemoryUnit(MemoryUnit *memUnit, int numCycles, StallStats *stallStats);
\ No newline at end of file
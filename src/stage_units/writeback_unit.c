@@ -30,6 +30,7 @@ void initWritebackUnit(WritebackUnit *writebackUnit, int NB, int NR) {
         cdb->destPhysReg = PHYS_REG_NONE;
         cdb->producedBy = VALUE_FROM_NONE;
         cdb->producingFUType = FU_TYPE_NONE;
+        cdb->producingFUIndex = -1;
 
         writebackUnit->cdbs[i] = cdb;
     }
@@ -43,12 +44,20 @@ void initWritebackUnit(WritebackUnit *writebackUnit, int NB, int NR) {
         info->numOperandsWaiting = 0;
         info->producedBy = VALUE_FROM_NONE;
         info->producingFUType = FU_TYPE_NONE;
+        info->producingFUIndex = -1;
         info->robIndex = i;
         info->valueType = VALUE_TYPE_NONE;
         info->addr = -1;
 
         writebackUnit->robWBInfoArr[i] = info;
     }
+
+    // at most one result per ROB entry can be ready in a cycle
+    writebackUnit->readyResults = malloc(NR * sizeof(int));
+    writebackUnit->numReadyResults = 0;
+    writebackUnit->readyResultsHeapSize = 0;
+
+    writebackUnit->numCommittedInsts = 0;
 }
 
 // free any elements of the writeback unit that were stored on the heap
@@ -71,43 +80,129 @@ void teardownWritebackUnit(WritebackUnit *writebackUnit) {
         }
         free(writebackUnit->robWBInfoArr);
     }
+
+    if (writebackUnit->readyResults) {
+        free(writebackUnit->readyResults);
+    }
 }
 
-// resets the array of ROBWBInfo structs
+// resets the ROBWBInfo structs filled in during the previous cycle, the others were never touched
 void resetWritebackUnitROBWBInfo(WritebackUnit *writebackUnit) {
 
-    for (int i = 0; i < writebackUnit->NR; i++) {
+    for (int j = 0; j < writebackUnit->numReadyResults; j++) {
+        int i = writebackUnit->readyResults[j];
         ROBWBInfo *info = writebackUnit->robWBInfoArr[i];
         info->floatVal = 0;
         info->intVal = 0;
         info->numOperandsWaiting = 0;
         info->producedBy = VALUE_FROM_NONE;
         info->producingFUType = FU_TYPE_NONE;
+        info->producingFUIndex = -1;
         info->valueType = VALUE_TYPE_NONE;
         info->robIndex = i;
         info->addr = -1;
     }
+
+    writebackUnit->numReadyResults = 0;
+    writebackUnit->readyResultsHeapSize = 0;
 }
 
-// updates the number of operands in reservation station entries that are waiting for different ROBs
-void updateWritebackUnitWaitingForROB(WritebackUnit *writebackUnit, ResStationStatusTableEntry **resStationEntries, int numEntries) {
-    
-    // iterate over given reservation stations
-    for (int i = 0; i < numEntries; i++) {
-        ResStationStatusTableEntry *entry = resStationEntries[i];
-
-        // increase the counter for the source ROB if the operand is not available
-        if (entry->busy) {
-            if (!entry->vjIsAvailable && entry->qj != -1) {
-                writebackUnit->robWBInfoArr[entry->qj]->numOperandsWaiting++;
-            }
-            if (!entry->vkIsAvailable && entry->qk != -1) {
-                writebackUnit->robWBInfoArr[entry->qk]->numOperandsWaiting++;
-            }
+// records that a functional unit result for a given ROB is available to be placed on the CDB this cycle
+void addReadyResultToWritebackUnit(WritebackUnit *writebackUnit, int robIndex) {
+    writebackUnit->readyResults[writebackUnit->numReadyResults++] = robIndex;
+}
+
+// returns 1 if the ready result for robA should be placed on the CDB before the one for robB
+// results with more operands waiting on them go first, ties go to the instruction closest to the head of the ROB
+int readyResultHasPriority(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int robA, int robB) {
+
+    int opsWaitingA = writebackUnit->robWBInfoArr[robA]->numOperandsWaiting;
+    int opsWaitingB = writebackUnit->robWBInfoArr[robB]->numOperandsWaiting;
+
+    if (opsWaitingA != opsWaitingB) {
+        return opsWaitingA > opsWaitingB;
+    }
+
+    return indexDistanceToROBHead(robTable, robA) < indexDistanceToROBHead(robTable, robB);
+}
+
+// moves the ready result at a given heap position up until its parent has priority over it
+void siftUpReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int pos) {
+
+    int *heap = writebackUnit->readyResults;
+
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!readyResultHasPriority(writebackUnit, robTable, heap[pos], heap[parent])) {
+            break;
+        }
+
+        int temp = heap[parent];
+        heap[parent] = heap[pos];
+        heap[pos] = temp;
+        pos = parent;
+    }
+}
+
+// moves the ready result at a given heap position down until it has priority over both of its children
+void siftDownReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int pos) {
+
+    int *heap = writebackUnit->readyResults;
+    int heapSize = writebackUnit->readyResultsHeapSize;
+
+    while (1) {
+        int highest = pos;
+        int left = 2 * pos + 1;
+        int right = 2 * pos + 2;
+
+        if (left < heapSize && readyResultHasPriority(writebackUnit, robTable, heap[left], heap[highest])) {
+            highest = left;
         }
+        if (right < heapSize && readyResultHasPriority(writebackUnit, robTable, heap[right], heap[highest])) {
+            highest = right;
+        }
+        if (highest == pos) {
+            break;
+        }
+
+        int temp = heap[highest];
+        heap[highest] = heap[pos];
+        heap[pos] = temp;
+        pos = highest;
+    }
+}
+
+// counts the operands waiting on each ready result and arranges the ready results into a heap ordered by priority
+void buildReadyResultHeap(WritebackUnit *writebackUnit, ROBStatusTable *robTable, ResStationStatusTable *resStationTable) {
+
+    for (int i = 0; i < writebackUnit->numReadyResults; i++) {
+        int robIndex = writebackUnit->readyResults[i];
+        writebackUnit->robWBInfoArr[robIndex]->numOperandsWaiting = numOperandsWaitingForROB(resStationTable, robIndex);
+
+        writebackUnit->readyResultsHeapSize = i + 1;
+        siftUpReadyResult(writebackUnit, robTable, i);
     }
 }
 
+// removes the ready result with the highest priority from the heap and returns its ROB index, -1 if there are none left
+// popped results are kept after the end of the heap so they can be reset at the start of the next cycle
+int popReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable) {
+
+    if (writebackUnit->readyResultsHeapSize == 0) {
+        return -1;
+    }
+
+    int *heap = writebackUnit->readyResults;
+    int last = --writebackUnit->readyResultsHeapSize;
+
+    int robIndex = heap[0];
+    heap[0] = heap[last];
+    heap[last] = robIndex;
+    siftDownReadyResult(writebackUnit, robTable, 0);
+
+    return robIndex;
+}
+
 // helper method to print the contents of ROBWBInfo's 
 void printWritebackUnitROBInfo(WritebackUnit *writebackUnit) {
 
@@ -124,11 +219,13 @@ void printWritebackUnitROBInfo(WritebackUnit *writebackUnit) {
 // helper method to print the contents of the CDBs
 void printWritebackUnitCDBs(WritebackUnit *writebackUnit) {
     printf("CDBs: numUsed: %i\n", writebackUnit->cdbsUsed);
+    char regName[PHYS_REG_NAME_SIZE];
+
     for (int i = 0; i < writebackUnit->NB; i++) {
         CDB *cdb = writebackUnit->cdbs[i];
 
         printf("\tCDB: %i, robIndex: %i, intVal: %i, floatVal: %f, valueType: %s, destPhysReg: %s, producedByType: %s producingFUType: %s\n", i, cdb->robIndex, cdb->intVal, cdb->floatVal, 
-            valueTypeToString(cdb->valueType), physicalRegisterNameToString(cdb->destPhysReg), valueProducedByToString(cdb->producedBy), fuTypeToString(cdb->producingFUType));
+            valueTypeToString(cdb->valueType), physicalRegisterNameToString(cdb->destPhysReg, regName), valueProducedByToString(cdb->producedBy), fuTypeToString(cdb->producingFUType));
     }
 }
 
@@ -141,10 +238,12 @@ void addROBEntryToCDB(WritebackUnit *writebackUnit, ROBStatusTableEntry *entry)
     cdb->robIndex = entry->index;
     cdb->valueType = entry->instResultValueType;
     cdb->producingFUType = entry->fuType;
+    cdb->producingFUIndex = -1;
 
-    // place branch instruction addresses on the CDB
+    // place branch instruction addresses and the return addresses of jumps on the CDB
     if (entry->fuType == FU_TYPE_BU) {
         cdb->addr = entry->addr;
+        cdb->intVal = entry->intValue;
     
     // place load/store information on the CDB
     } else if (entry->fuType == FU_TYPE_STORE || entry->fuType == FU_TYPE_LOAD) {
@@ -165,16 +264,151 @@ void addROBEntryToCDB(WritebackUnit *writebackUnit, ROBStatusTableEntry *entry)
     }
 }
 
+// reads the current results of a group of FP functional units into the ROBWBInfo structs
+void addFPFunctionalUnitResultsToROBWBInfo(WritebackUnit *writebackUnit, FPFunctionalUnit *fpFUs, int numFPFUs) {
+
+    for (int i = 0; i < numFPFUs; i++) {
+        FPFunctionalUnit *fpFU = &fpFUs[i];
+
+        FloatFUResult *currFPFUResult = getCurrentFPFunctionalUnitResult(fpFU);
+        if (currFPFUResult) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("destROB: %i, value: %f read from %s functional unit: %i result\n", currFPFUResult->destROB, currFPFUResult->result, fuTypeToString(fpFU->fuType), i);
+            #endif
+
+            ROBWBInfo *info = writebackUnit->robWBInfoArr[currFPFUResult->destROB];
+
+            #ifdef ENABLE_DEBUG_LOG
+            if (info->producedBy != VALUE_FROM_NONE) {
+                printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
+            }
+            #endif
+
+            info->producedBy = VALUE_FROM_FU;
+            info->producingFUType = fpFU->fuType;
+            addReadyResultToWritebackUnit(writebackUnit, currFPFUResult->destROB);
+            info->producingFUIndex = i;
+            info->floatVal = currFPFUResult->result;
+            info->valueType = VALUE_TYPE_FLOAT;
+
+            // stall functional unit by default and remove the stall later if its result is placed on the CDB
+            fpFU->isStalled = 1;
+        } else {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("no result available from %s functional unit: %i\n", fuTypeToString(fpFU->fuType), i);
+            #endif
+        }
+    }
+}
+
+// removes every instruction younger than the one at the head of the ROB from the pipeline, the head instruction itself
+// is left for the caller to commit. the rename state has to be restored separately
+void flushInstructionsAfterROBHead(FetchUnit *fetchUnit, DecodeUnit *decodeUnit, MemoryUnit *memUnit, StatusTables *statusTables, FunctionalUnits *functionalUnits) {
+
+    ROBStatusTable *robTable = statusTables->robTable;
+
+    // return the instructions being flushed from the ROB to the pool
+    for (int i = 1; i < robTable->count; i++) {
+        
+        ROBStatusTableEntry *robEntryToReset = &robTable->entries[(robTable->headEntryIndex + i) % robTable->NR];
+        Instruction *inst = robEntryToReset->inst;
+
+        // the flushed instruction will never commit
+        if (inst && robEntryToReset->busy) {
+            releaseInstruction(decodeUnit->instPool, inst);
+            robEntryToReset->inst = NULL;
+        }
+    }
+
+    // reset buffers and queues
+    flushDecodeQueue(decodeUnit);
+    flushFetchBuffer(fetchUnit);
+
+    // flush the ROB
+    flushROB(robTable);
+
+    // flush the register status table
+    flushRegisterStatusTable(statusTables->regTable);
+    
+    // flush the reservation station status table
+    flushResStationStatusTable(statusTables->resStationTable);
+
+    // flush the load and store queues
+    flushLoadStoreQueue(statusTables->loadStoreQueue);
+
+    // reset functional units
+    for (int i = 0; i < functionalUnits->numBUFUs; i++) {
+        flushBUFunctionalUnit(&functionalUnits->buFUs[i]);
+    }
+    for (int i = 0; i < functionalUnits->numIntFUs; i++) {
+        flushIntFunctionalUnit(&functionalUnits->intFUs[i]);
+    }
+    for (int i = 0; i < functionalUnits->numFPAddFUs; i++) {
+        flushFPFunctionalUnit(&functionalUnits->fpAddFUs[i]);
+    }
+    for (int i = 0; i < functionalUnits->numFPMulFUs; i++) {
+        flushFPFunctionalUnit(&functionalUnits->fpMulFUs[i]);
+    }
+    for (int i = 0; i < functionalUnits->numFPDivFUs; i++) {
+        flushFPFunctionalUnit(&functionalUnits->fpDivFUs[i]);
+    }
+    for (int i = 0; i < functionalUnits->numLSFUs; i++) {
+        flushLSFunctionalUnit(&functionalUnits->lsFUs[i]);
+    }
+    flushMemUnit(memUnit);
+}
+
+// writes the result of a committing instruction to the register file and frees the physical register its destination
+// was mapped to before it
+void commitResultToRegisterFile(CDB *cdb, ROBStatusTableEntry *robStatusEntry, StatusTables *statusTables, DecodeUnit *decodeUnit, RegisterFile *registerFile) {
+
+    // update reservation stations with value
+    if (cdb->valueType == VALUE_TYPE_INT) {
+        sendIntUpdateToResStationStatusTable(statusTables->resStationTable, cdb->robIndex, cdb->intVal, 1);
+    } else if (cdb->valueType == VALUE_TYPE_FLOAT) {
+        sendFloatUpdateToResStationStatusTable(statusTables->resStationTable, cdb->robIndex, cdb->floatVal, 1);
+    }
+
+    // get the reservation station associatied with the ROB
+    RegisterStatusTableEntry *regStatusEntry = registerStatusTableEntryForReg(statusTables->regTable, robStatusEntry->destReg);
+
+    // reset the register status table entry if the committed instruction's destination ROB matches the current entry's ROB
+    if (regStatusEntry && regStatusEntry->robIndex == robStatusEntry->index) {
+        regStatusEntry->robIndex = -1;
+    }
+
+    // do not try to pop BNE, FSD and discarded jump destination registers (they do not contain destReg values)
+    if (robStatusEntry->destReg) {
+        popOldPhysicalRegisterMappingForReg(decodeUnit, robStatusEntry->renamedDestReg, 1);
+    }
+
+    // update register file with int or float value
+    if (cdb->valueType == VALUE_TYPE_INT) {
+        #ifdef ENABLE_DEBUG_LOG
+        char regName[PHYS_REG_NAME_SIZE];
+        printf("\tcommiting: %i to register: %s\n", cdb->intVal, physicalRegisterNameToString(cdb->destPhysReg, regName));
+        #endif 
+
+        writeRegisterFileInt(registerFile, cdb->destPhysReg, cdb->intVal);
+    } else if (cdb->valueType == VALUE_TYPE_FLOAT) {
+        #ifdef ENABLE_DEBUG_LOG
+        char regName[PHYS_REG_NAME_SIZE];
+        printf("\tcommiting: %f to register: %s\n", cdb->floatVal, physicalRegisterNameToString(cdb->destPhysReg, regName));
+        #endif
+
+        writeRegisterFileFloat(registerFile, cdb->destPhysReg, cdb->floatVal);
+    }
+}
+
 // perform writeback unit operations during a cycle
 void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, DecodeUnit *decodeUnit, MemoryUnit *memUnit, StatusTables *statusTables, 
-    FunctionalUnits *functionalUnits, RegisterFile *registerFile, DataCache *dataCache, BranchPredictor *branchPredictor, StallStats *stallStats) {
+    FunctionalUnits *functionalUnits, RegisterFile *registerFile, DataCache *dataCache, BranchPredictor *branchPredictor, StallStats *stallStats, int cycle) {
 
     printf_DEBUG(("\nperforming writeback unit operations...\n"));
 
     // make status tables easier to access
     ROBStatusTable *robTable = statusTables->robTable;
     ResStationStatusTable *resStationTable = statusTables->resStationTable;
-    RegisterStatusTable *regTable = statusTables->regTable;
 
     // clear current CDB values
     for (int i = 0; i < writebackUnit->NB; i++) {
@@ -186,6 +420,7 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
         cdb->destPhysReg = PHYS_REG_NONE;
         cdb->producedBy = VALUE_FROM_NONE;
         cdb->producingFUType = FU_TYPE_NONE;
+        cdb->producingFUIndex = -1;
     }
     writebackUnit->cdbsUsed = 0;
 
@@ -197,8 +432,9 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
     // prioritize placing ROB entries on the CDB for commit
     if (writebackUnit->cdbsUsed < writebackUnit->NB) {
 
-        for (int i = 0; i < writebackUnit->NB - writebackUnit->cdbsUsed; i++) {
-            ROBStatusTableEntry *nextHeadEntry = robTable->entries[(robTable->headEntryIndex + numInstsToCommit) % robTable->NR];
+        // stop once every busy entry was taken, since the next index wraps back around to the head
+        for (int i = 0; i < writebackUnit->NB - writebackUnit->cdbsUsed && numInstsToCommit < robTable->count; i++) {
+            ROBStatusTableEntry *nextHeadEntry = &robTable->entries[(robTable->headEntryIndex + numInstsToCommit) % robTable->NR];
 
             // check if next head ROB is read to commit
             if (nextHeadEntry->busy && nextHeadEntry->state == INST_STATE_WROTE_RESULT) {
@@ -225,7 +461,7 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
         printf("destROB: %i, address: %i, fuType: %s, value: %f\n", currLSFUResult->destROB, currLSFUResult->resultAddr, fuTypeToString(currLSFUResult->fuType), currLSFUResult->loadValue);
         #endif
 
-        ROBStatusTableEntry *entry = robTable->entries[currLSFUResult->destROB];
+        ROBStatusTableEntry *entry = &robTable->entries[currLSFUResult->destROB];
         ROBWBInfo *info = writebackUnit->robWBInfoArr[currLSFUResult->destROB];
         
         #ifdef ENABLE_DEBUG_LOG
@@ -236,6 +472,7 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
 
         info->producedBy = VALUE_FROM_FU;
         info->producingFUType = currLSFUResult->fuType;
+        addReadyResultToWritebackUnit(writebackUnit, currLSFUResult->destROB);
         info->addr = currLSFUResult->resultAddr;
 
         if (info->producingFUType == FU_TYPE_LOAD) {
@@ -250,205 +487,133 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
         printf_DEBUG(("no result available from memory unit\n"));
     }
 
-    // check the produced results from INT functional unit
-    IntFUResult *currIntFUResult = getCurrentIntFunctionalUnitResult(functionalUnits->intFU);
-    if (currIntFUResult) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("destROB: %i, value: %i read from INT functional unit result\n", currIntFUResult->destROB, currIntFUResult->result);
-        #endif
-
-        ROBStatusTableEntry *entry = robTable->entries[currIntFUResult->destROB];
-        ROBWBInfo *info = writebackUnit->robWBInfoArr[currIntFUResult->destROB];
+    // check the loads whose lines were filled after missing in the data cache
+    for (int i = 0; i < memUnit->numMissedLoadSlots; i++) {
+        MissedLoad *missedLoad = &memUnit->missedLoads[i];
 
-        #ifdef ENABLE_DEBUG_LOG
-        if (info->producedBy != VALUE_FROM_NONE) {
-            printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
+        if (!missedLoad->busy || missedLoad->mshrIndex != -1) {
+            continue;
         }
-        #endif
 
-        info->producedBy = VALUE_FROM_FU;
-        info->producingFUType = FU_TYPE_INT;
-        info->intVal = currIntFUResult->result;
-        info->valueType = VALUE_TYPE_INT;
-
-        // stall functional unit by default and remove the stall later if its result is placed on the CDB
-        functionalUnits->intFU->isStalled = 1;
-    } else {
-        printf_DEBUG(("no result available from INT functional unit\n"));
-    }
-
-    // check the produced results from FPAdd functional unit
-    FloatFUResult *currFPAddFUResult = getCurrentFPFunctionalUnitResult(functionalUnits->fpAddFU);
-    if (currFPAddFUResult) {
         #ifdef ENABLE_DEBUG_LOG
-        printf("destROB: %i, value: %f read from FPAdd functional unit result\n", currFPAddFUResult->destROB, currFPAddFUResult->result);
+        printf("destROB: %i, address: %i, value: %f read from missed load\n", missedLoad->destROB, missedLoad->resultAddr, missedLoad->loadValue);
         #endif
 
-        ROBStatusTableEntry *entry = robTable->entries[currFPAddFUResult->destROB];
-        ROBWBInfo *info = writebackUnit->robWBInfoArr[currFPAddFUResult->destROB];
-
-        #ifdef ENABLE_DEBUG_LOG
-        if (info->producedBy != VALUE_FROM_NONE) {
-            printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
-        }
-        #endif
+        ROBWBInfo *info = writebackUnit->robWBInfoArr[missedLoad->destROB];
 
         info->producedBy = VALUE_FROM_FU;
-        info->producingFUType = FU_TYPE_FPADD;
-        info->floatVal = currFPAddFUResult->result;
+        info->producingFUType = FU_TYPE_LOAD;
+        addReadyResultToWritebackUnit(writebackUnit, missedLoad->destROB);
+        info->addr = missedLoad->resultAddr;
+        info->floatVal = missedLoad->loadValue;
         info->valueType = VALUE_TYPE_FLOAT;
-
-        // stall functional unit by default and remove the stall later if its result is placed on the CDB
-        functionalUnits->fpAddFU->isStalled = 1;
-    } else {
-        printf_DEBUG(("no result available from FPAdd functional unit\n"));
     }
 
-    // check the produced results from FPMul functional unit
-    FloatFUResult *currFpMulFUResult = getCurrentFPFunctionalUnitResult(functionalUnits->fpMulFU);
-    if (currFpMulFUResult) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("destROB: %i, value: %f read from FPMul functional unit result\n", currFpMulFUResult->destROB, currFpMulFUResult->result);
-        #endif
-
-        ROBStatusTableEntry *entry = robTable->entries[currFpMulFUResult->destROB];
-        ROBWBInfo *info = writebackUnit->robWBInfoArr[currFpMulFUResult->destROB];
-
-        #ifdef ENABLE_DEBUG_LOG
-        if (info->producedBy != VALUE_FROM_NONE) {
-            printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
-        }
-        #endif
+    // check the produced results from each INT functional unit
+    for (int i = 0; i < functionalUnits->numIntFUs; i++) {
+        IntFunctionalUnit *intFU = &functionalUnits->intFUs[i];
 
-        info->producedBy = VALUE_FROM_FU;
-        info->producingFUType = FU_TYPE_FPMUL;
-        info->floatVal = currFpMulFUResult->result;
-        info->valueType = VALUE_TYPE_FLOAT;
+        IntFUResult *currIntFUResult = getCurrentIntFunctionalUnitResult(intFU);
+        if (currIntFUResult) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("destROB: %i, value: %i read from INT functional unit: %i result\n", currIntFUResult->destROB, currIntFUResult->result, i);
+            #endif
 
-        // stall functional unit by default and remove the stall later if its result is placed on the CDB
-        functionalUnits->fpMulFU->isStalled = 1;
-    } else {
-        printf_DEBUG(("no result available from FPMul functional unit\n"));
-    }
+            ROBStatusTableEntry *entry = &robTable->entries[currIntFUResult->destROB];
+            ROBWBInfo *info = writebackUnit->robWBInfoArr[currIntFUResult->destROB];
 
-    // check the produced results from FPMul functional unit
-    FloatFUResult *currFpDivFUResult = getCurrentFPFunctionalUnitResult(functionalUnits->fpDivFU);
-    if (currFpDivFUResult) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("destROB: %i, value: %f read from FPDiv functional unit result\n", currFpDivFUResult->destROB, currFpDivFUResult->result);
-        #endif
+            #ifdef ENABLE_DEBUG_LOG
+            if (info->producedBy != VALUE_FROM_NONE) {
+                printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
+            }
+            #endif
 
-        ROBStatusTableEntry *entry = robTable->entries[currFpDivFUResult->destROB];
-        ROBWBInfo *info = writebackUnit->robWBInfoArr[currFpDivFUResult->destROB];
+            info->producedBy = VALUE_FROM_FU;
+            info->producingFUType = FU_TYPE_INT;
+            addReadyResultToWritebackUnit(writebackUnit, currIntFUResult->destROB);
+            info->producingFUIndex = i;
+            info->intVal = currIntFUResult->result;
+            info->valueType = VALUE_TYPE_INT;
 
-        #ifdef ENABLE_DEBUG_LOG
-        if (info->producedBy != VALUE_FROM_NONE) {
-            printf("error: destination ROB found in functional unit was already seen, this shouldn't happen...\n");
+            // stall functional unit by default and remove the stall later if its result is placed on the CDB
+            intFU->isStalled = 1;
+        } else {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("no result available from INT functional unit: %i\n", i);
+            #endif
         }
-        #endif
+    }
 
-        info->producedBy = VALUE_FROM_FU;
-        info->producingFUType = FU_TYPE_FPDIV;
-        info->floatVal = currFpDivFUResult->result;
-        info->valueType = VALUE_TYPE_FLOAT;
+    // check the produced results from each FP functional unit
+    addFPFunctionalUnitResultsToROBWBInfo(writebackUnit, functionalUnits->fpAddFUs, functionalUnits->numFPAddFUs);
+    addFPFunctionalUnitResultsToROBWBInfo(writebackUnit, functionalUnits->fpMulFUs, functionalUnits->numFPMulFUs);
+    addFPFunctionalUnitResultsToROBWBInfo(writebackUnit, functionalUnits->fpDivFUs, functionalUnits->numFPDivFUs);
 
-        // stall functional unit by default and remove the stall later if its result is placed on the CDB
-        functionalUnits->fpDivFU->isStalled = 1;
-    } else {
-        printf_DEBUG(("no result available from FPDiv functional unit\n"));
-    }
+    // check the produced results from each BU functional unit
+    for (int i = 0; i < functionalUnits->numBUFUs; i++) {
+        BUFunctionalUnit *buFU = &functionalUnits->buFUs[i];
 
-    // check the produced results from BU functional unit
-    BUFUResult *currBUFUResult = getCurrentBUFunctionalUnitResult(functionalUnits->buFU);
-    if (currBUFUResult) {
-        #ifdef ENABLE_DEBUG_LOG
-        printf("add BU result to CDB: isBranchTaken: %i, effective address: %i read from BU functional\n", currBUFUResult->isBranchTaken, currBUFUResult->effAddr);
-        #endif
+        BUFUResult *currBUFUResult = getCurrentBUFunctionalUnitResult(buFU);
+        if (currBUFUResult) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("add BU result to CDB: isBranchTaken: %i, effective address: %i read from BU functional\n", currBUFUResult->isBranchTaken, currBUFUResult->effAddr);
+            #endif
 
-        ROBStatusTableEntry *entry = robTable->entries[currBUFUResult->destROB];
+            ROBStatusTableEntry *entry = &robTable->entries[currBUFUResult->destROB];
         
-        // always try to place BU result on CDB if there is space
-        if (writebackUnit->cdbsUsed < writebackUnit->NB) {
+            // always try to place BU result on CDB if there is space
+            if (writebackUnit->cdbsUsed < writebackUnit->NB) {
             
-            CDB *cdb = writebackUnit->cdbs[writebackUnit->cdbsUsed++];
-            cdb->producingFUType = FU_TYPE_BU;
-            cdb->destPhysReg = PHYS_REG_NONE;
-            cdb->valueType = VALUE_TYPE_NONE;
-            cdb->producedBy = VALUE_FROM_FU;
-            cdb->robIndex = currBUFUResult->destROB;
-            cdb->addr = currBUFUResult->effAddr;
-            cdb->buTookBranch = currBUFUResult->isBranchTaken;
+                CDB *cdb = writebackUnit->cdbs[writebackUnit->cdbsUsed++];
+                cdb->producingFUType = FU_TYPE_BU;
+                cdb->producingFUIndex = i;
+                cdb->destPhysReg = PHYS_REG_NONE;
+                cdb->producedBy = VALUE_FROM_FU;
+                cdb->robIndex = currBUFUResult->destROB;
+
+                // jumps also send their return address to the instructions waiting on it
+                cdb->valueType = entry->instResultValueType;
+                cdb->intVal = currBUFUResult->linkAddr;
+                cdb->addr = currBUFUResult->effAddr;
+                cdb->buTookBranch = currBUFUResult->isBranchTaken;
 
-            functionalUnits->buFU->isStalled = 0;
+                buFU->isStalled = 0;
+
+            } else {
+                #ifdef ENABLE_DEBUG_LOG
+                printf("\tdestROB: %i is not busy, ignoring results\n", currBUFUResult->destROB);
+                #endif
+                buFU->isStalled = 1;
+            }
 
         } else {
             #ifdef ENABLE_DEBUG_LOG
-            printf("\tdestROB: %i is not busy, ignoring results\n", currBUFUResult->destROB);
+            printf("no result available from BU functional unit: %i\n", i);
             #endif
-            functionalUnits->buFU->isStalled = 1;
         }
-
-    } else {
-        printf_DEBUG(("no result available from BU functional unit\n"));
     }
 
-    // increase the robsNeededBy counters for every functional unit's reservation stations
+    // order the functional unit results by the number of operands waiting on them
     // the more operands that are waiting for a ROB, the higher priority it has to be placed on the CDB
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->intEntries, resStationTable->numIntStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->loadEntries, resStationTable->numLoadStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->storeEntries, resStationTable->numStoreStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->fpAddEntries, resStationTable->numFPAddStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->fpMulEntries, resStationTable->numFPMulStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->fpDivEntries, resStationTable->numFPDivStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->buEntries, resStationTable->numBUStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->loadEntries, resStationTable->numLoadStations);
-    updateWritebackUnitWaitingForROB(writebackUnit, resStationTable->storeEntries, resStationTable->numStoreStations);
+    buildReadyResultHeap(writebackUnit, robTable, resStationTable);
 
     #ifdef ENABLE_DEBUG_LOG
     printWritebackUnitROBInfo(writebackUnit);
     #endif
 
     // find which values from functional units to send on the CDB
-    for (int i = 0; i < writebackUnit->NB && writebackUnit->cdbsUsed < writebackUnit->NB; i++) {
-
-        // find the ROB dest with the maximum number of operands waiting on it
-        int maxOpsWaiting = -1;
-        int maxOpsROB = -1;
-
-        // iterate over every ROBWBInfo struct
-        for (int j = 0; j < writebackUnit->NR; j++) {
-
-            // check if the current ROB dest is already in the CDB
-            int alreadyInCDB = 0;
-            for (int k = 0; k < writebackUnit->cdbsUsed; k++) {
-                if (writebackUnit->cdbs[k]->robIndex == j) {
-                    alreadyInCDB = 1;
-                    break;
-                }
-            }
-            if (alreadyInCDB) {
-                continue;
-            }
+    while (writebackUnit->cdbsUsed < writebackUnit->NB) {
 
-            // check the ROBWBInfo struct for the number of operands waiting for it
-            ROBWBInfo *info = writebackUnit->robWBInfoArr[j];
-            if (info->producedBy == VALUE_FROM_FU) {
-                if (info->numOperandsWaiting > maxOpsWaiting) {
-                    maxOpsWaiting = info->numOperandsWaiting;
-                    maxOpsROB = info->robIndex; // same as j
-                }
-            }
-        }
+        // take the ready result with the maximum number of operands waiting on it
+        int maxOpsROB = popReadyResult(writebackUnit, robTable);
 
-        // no more operands are waiting for a ROB, nothing more to be placed on the CDB
+        // no more functional unit results are ready, nothing more to be placed on the CDB
         if (maxOpsROB == -1) {
             printf_DEBUG(("no ROB with maximum number of waiting operands found\n"));
             break;
 
         // a ROB was selected as having the highest number of operands waiting for it, write it on the CDB
         } else {
-            
-
             ROBWBInfo *info = writebackUnit->robWBInfoArr[maxOpsROB];
             CDB *cdb = writebackUnit->cdbs[writebackUnit->cdbsUsed];
 
@@ -456,6 +621,7 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
             cdb->producedBy = VALUE_FROM_FU;
             cdb->robIndex = maxOpsROB;
             cdb->producingFUType = info->producingFUType;
+            cdb->producingFUIndex = info->producingFUIndex;
             cdb->addr = info->addr;
             
             // the value is from the INT functional unit
@@ -500,7 +666,7 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
             #endif
 
             // update the ROB status table and reservation stations that are waiting for the result
-            ROBStatusTableEntry *robStatusEntry = robTable->entries[cdb->robIndex];
+            ROBStatusTableEntry *robStatusEntry = &robTable->entries[cdb->robIndex];
             robStatusEntry->state = INST_STATE_WROTE_RESULT;
 
             if (cdb->valueType == VALUE_TYPE_INT) {
@@ -517,26 +683,26 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
 
             // don't actually stall the functional units (among other things)
             if (cdb->producingFUType == FU_TYPE_INT) {
-                functionalUnits->intFU->isStalled = 0;
+                functionalUnits->intFUs[cdb->producingFUIndex].isStalled = 0;
             } else if (cdb->producingFUType == FU_TYPE_LOAD) {
-                memUnit->isStalledFromWB = 0;
+                // a missed load is freed once written back, otherwise the load came from the memory unit itself
+                if (!releaseMissedLoadForROB(memUnit, cdb->robIndex)) {
+                    memUnit->isStalledFromWB = 0;
+                }
             } else if (cdb->producingFUType == FU_TYPE_STORE) {
                 memUnit->isStalledFromWB = 0;
 
                 robStatusEntry->addr = cdb->addr;
                 robStatusEntry->floatValue = resStationEntry->vjFloat;
 
-                // forward the float value to the memory unit for the subsequent load to use
-                forwardDataToMemoryUnit(memUnit, robStatusEntry->floatValue, robStatusEntry->addr);
-
             } else if (cdb->producingFUType == FU_TYPE_FPADD) {
-                functionalUnits->fpAddFU->isStalled = 0;
+                functionalUnits->fpAddFUs[cdb->producingFUIndex].isStalled = 0;
             } else if (cdb->producingFUType == FU_TYPE_FPMUL) {
-                functionalUnits->fpMulFU->isStalled = 0;
+                functionalUnits->fpMulFUs[cdb->producingFUIndex].isStalled = 0;
             } else if (cdb->producingFUType == FU_TYPE_FPDIV) {
-                functionalUnits->fpDivFU->isStalled = 0;
+                functionalUnits->fpDivFUs[cdb->producingFUIndex].isStalled = 0;
             } else if (cdb->producingFUType == FU_TYPE_BU) {
-                functionalUnits->buFU->isStalled = 0;
+                functionalUnits->buFUs[cdb->producingFUIndex].isStalled = 0;
 
                 // set target address calculated in the branch unit
                 robStatusEntry->addr = cdb->addr;
@@ -550,34 +716,43 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
         } else if (cdb->producedBy == VALUE_FROM_ROB) {
 
             // update ROB status table
-            ROBStatusTableEntry *robStatusEntry = robTable->entries[cdb->robIndex];
-            robStatusEntry->busy = 0;
+            ROBStatusTableEntry *robStatusEntry = &robTable->entries[cdb->robIndex];
             robStatusEntry->state = INST_STATE_COMMIT;
+            writebackUnit->numCommittedInsts++;
+
+            // the pipeline has refilled after the last misprediction
+            endMispredictionFlush(branchPredictor, cycle);
 
-            // a bne instruction is committing
+            // a branch or jump instruction is committing
             if (cdb->producingFUType == FU_TYPE_BU) {
                 #ifdef ENABLE_DEBUG_LOG
                 printf("CDB: %i contains value from ROB, updating ROB: %i to COMMITED and updating branch predictor and ROB\n", i, cdb->robIndex);
-                printf("\ncdb->addr: %i, predictNextPC: %i\n", cdb->addr, predictNextPC(branchPredictor, robStatusEntry->inst->addr));
+                printf("\ncdb->addr: %i, predictedNextPC: %i\n", cdb->addr, robStatusEntry->inst->predictedNextPC);
                 #endif
 
-                // check if the branch prediction was correct
-                if (cdb->addr == predictNextPC(branchPredictor, robStatusEntry->inst->addr)) { 
-                    
-                    // update the state of the branch predictor that the speculated branch was correct
-                    updateBranchPredictor(branchPredictor, 1);
+                Instruction *branchInst = robStatusEntry->inst;
+                int branchWasTaken = cdb->addr != branchInst->addr + 4;
+                int predictionWasCorrect = cdb->addr == branchInst->predictedNextPC;
 
-                    // update BTB
-                    updateBTBEntry(branchPredictor, robStatusEntry->inst->addr, cdb->addr);
+                // jumps write their return address like any other instruction, before a misprediction flushes the instructions after them
+                commitResultToRegisterFile(cdb, robStatusEntry, statusTables, decodeUnit, registerFile);
 
-                // branch prediction was incorrect
+                // update the state of the branch predictor with the outcome of the branch and update the BTB
+                if (branchInst->type == BNE) {
+                    updateBranchPredictor(branchPredictor, branchInst->addr, branchInst->branchHistory, branchWasTaken, predictionWasCorrect);
+                    updateBTBEntry(branchPredictor, branchInst->addr, cdb->addr);
                 } else {
-                    
-                    // update the state of the branch predictor that the speculated branch was incorrect
-                    updateBranchPredictor(branchPredictor, 0);
+                    updateJumpPredictor(branchPredictor, branchInst, cdb->addr, predictionWasCorrect);
+                }
+
+                // check if the prediction made when the branch was fetched was correct
+                if (predictionWasCorrect) { 
 
-                    // update BTB
-                    updateBTBEntry(branchPredictor, robStatusEntry->inst->addr, cdb->addr);
+                    // the branch's rename checkpoint is no longer needed
+                    releaseOldestRenameCheckpoint(decodeUnit);
+
+                // branch prediction was incorrect
+                } else {
 
                     #ifdef ENABLE_DEBUG_LOG
                     printFreeList(decodeUnit);
@@ -585,52 +760,23 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
                     printROBStatusTable(robTable);
                     #endif
 
-                    // add all allocated physical registers back to the free list
-                    for (int i = (robTable->headEntryIndex + 1) % robTable->NR; i != robTable->headEntryIndex; i = (i + 1) % robTable->NR) {
-                        
-                        ROBStatusTableEntry *robEntryToReset = robTable->entries[i];
-                        Instruction *inst = robEntryToReset->inst;
-
-                        if (inst) {
-                            enum InstructionType instType = inst->type;
-                            
-                            // do not pop entries for instructions that do not write to registers
-                            if (instType != BNE && instType != FSD) {
-                                
-                                if (robEntryToReset->busy && robEntryToReset->destReg) {
-                                    popNewPhysicalRegisterMappingForReg(decodeUnit, robEntryToReset->destReg, 0);
-                                }
-                            }
-                        }
-                    }
-
-                    // reset buffers and queues
-                    flushDecodeQueue(decodeUnit);
-                    flushFetchBuffer(fetchUnit);
+                    // restore the map table and free list to their state when the branch was issued
+                    restoreOldestRenameCheckpoint(decodeUnit);
 
-                    // flush the ROB
-                    flushROB(robTable);
-
-                    // flush the register status table
-                    flushRegisterStatusTable(regTable);
-                    
-                    // flush the reservation station status table
-                    flushResStationStatusTable(resStationTable);
+                    // remove every instruction younger than the branch from the pipeline
+                    startMispredictionFlush(branchPredictor, cycle, robTable->count - 1);
+                    flushInstructionsAfterROBHead(fetchUnit, decodeUnit, memUnit, statusTables, functionalUnits);
+                    restoreBranchHistory(branchPredictor);
 
                     // write the correct PC value to the register file
                     writeRegisterFileInt(registerFile, PHYS_REG_PC, cdb->addr);
 
-                    // reset functional units
-                    flushBUFunctionalUnit(functionalUnits->buFU);
-                    flushIntFunctionalUnit(functionalUnits->intFU);
-                    flushFPFunctionalUnit(functionalUnits->fpAddFU);
-                    flushFPFunctionalUnit(functionalUnits->fpMulFU);
-                    flushFPFunctionalUnit(functionalUnits->fpDivFU);
-                    flushLSFunctionalUnit(functionalUnits->lsFU);
-                    flushMemUnit(memUnit);
-
                     // update ROB head
-                    robTable->headEntryIndex = (robStatusEntry->index+1) % robTable->NR;
+                    removeHeadEntryFromROB(robTable);
+
+                    // return the committed branch to the instruction pool
+                    releaseInstruction(decodeUnit->instPool, robStatusEntry->inst);
+                    robStatusEntry->inst = NULL;
 
                     // stop processing CDB values
                     break;                        
@@ -642,53 +788,70 @@ void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, Deco
                 printf("CDB: %i contains value from ROB, updating ROB: %i to COMMITED and writing the result to register file\n", i, cdb->robIndex);
                 #endif
 
-                // update reservation stations with value
-                if (cdb->valueType == VALUE_TYPE_INT) {
-                    sendIntUpdateToResStationStatusTable(resStationTable, cdb->robIndex, cdb->intVal, 1);
-                } else if (cdb->valueType == VALUE_TYPE_FLOAT) {
-                    sendFloatUpdateToResStationStatusTable(resStationTable, cdb->robIndex, cdb->floatVal, 1);
+                // a load that read its value before an older store to the same address resolved has a stale value. every older
+                // store has committed by now, so the correct value is read from the data cache and the instructions after the load,
+                // which may have used the stale value, are squashed below
+                LoadStoreQueueEntry *violatingLoad = NULL;
+                if (cdb->producingFUType == FU_TYPE_LOAD) {
+                    LoadStoreQueueEntry *loadEntry = loadStoreQueueEntryForROB(statusTables->loadStoreQueue, cdb->robIndex, FU_TYPE_LOAD);
+
+                    if (loadEntry->violatingStorePC != -1) {
+                        violatingLoad = loadEntry;
+                        cdb->floatVal = readFloatFromDataCache(dataCache, loadEntry->addr);
+
+                        #ifdef ENABLE_DEBUG_LOG
+                        printf("load for ROB: %i violated memory ordering with the store at: %i, reloaded: %f from address: %i\n", cdb->robIndex, loadEntry->violatingStorePC,
+                            cdb->floatVal, loadEntry->addr);
+                        #endif
+                    }
                 }
 
-                // get the reservation station associatied with the ROB
-                RegisterStatusTableEntry *regStatusEntry = registerStatusTableEntryForReg(regTable, robStatusEntry->destReg);
+                commitResultToRegisterFile(cdb, robStatusEntry, statusTables, decodeUnit, registerFile);
+
+                // update memory if committing a store
+                if (cdb->producingFUType == FU_TYPE_STORE) {
+                    #ifdef ENABLE_DEBUG_LOG
+                    printf("\twriting %f to memory address: %i\n", cdb->floatVal, cdb->addr);
+                    #endif 
+
+                    writeFloatToDataCache(dataCache, cdb->addr, cdb->floatVal);
 
-                // reset the register status table entry if the committed instruction's destination ROB matches the current entry's ROB
-                if (regStatusEntry && regStatusEntry->robIndex == robStatusEntry->index) {
-                    regStatusEntry->robIndex = -1;
+                    // committed stores drain into the L1 data cache without holding up commit
+                    accessL1DataCache(dataCache, cdb->addr, cycle, 0);
                 }
 
-                // do not try to pop BNE and FSD destination registers (they do not contain destReg values)
-                if (robStatusEntry->destReg) {
-                    popOldPhysicalRegisterMappingForReg(decodeUnit, robTable, robStatusEntry->destReg, 1);
+                // committed loads and stores leave the load/store queue
+                if (cdb->producingFUType == FU_TYPE_LOAD || cdb->producingFUType == FU_TYPE_STORE) {
+                    removeHeadFromLoadStoreQueue(statusTables->loadStoreQueue, cdb->producingFUType);
                 }
 
-                // update register file with int or float value
-                if (cdb->valueType == VALUE_TYPE_INT) {
-                    #ifdef ENABLE_DEBUG_LOG
-                    printf("\tcommiting: %i to register: %s\n", cdb->intVal, physicalRegisterNameToString(cdb->destPhysReg));
-                    #endif 
+                // restart execution from the instruction after the load
+                if (violatingLoad) {
+                    statusTables->loadStoreQueue->numOrderingViolations++;
 
-                    writeRegisterFileInt(registerFile, cdb->destPhysReg, cdb->intVal);
-                } else if (cdb->valueType == VALUE_TYPE_FLOAT) {
-                    #ifdef ENABLE_DEBUG_LOG
-                    printf("\tcommiting: %f to register: %s\n", cdb->floatVal, physicalRegisterNameToString(cdb->destPhysReg));
-                    #endif
+                    flushInstructionsAfterROBHead(fetchUnit, decodeUnit, memUnit, statusTables, functionalUnits);
+                    restoreCommittedRenameState(decodeUnit);
+                    restoreBranchHistory(branchPredictor);
+                    writeRegisterFileInt(registerFile, PHYS_REG_PC, robStatusEntry->inst->addr + 4);
 
-                    writeRegisterFileFloat(registerFile, cdb->destPhysReg, cdb->floatVal);
-                }
+                    // update ROB head
+                    removeHeadEntryFromROB(robTable);
 
-                // update memory if committing a store
-                if (cdb->producingFUType == FU_TYPE_STORE) {
-                    #ifdef ENABLE_DEBUG_LOG
-                    printf("\twriting %f to memory address: %i\n", cdb->floatVal, cdb->addr);
-                    #endif 
+                    // return the committed load to the instruction pool
+                    releaseInstruction(decodeUnit->instPool, robStatusEntry->inst);
+                    robStatusEntry->inst = NULL;
 
-                    writeFloatToDataCache(dataCache, cdb->addr, cdb->floatVal);
+                    // stop processing CDB values
+                    break;
                 }
             }
         
             // update the ROB head
-            robTable->headEntryIndex = (robStatusEntry->index+1) % robTable->NR;
+            removeHeadEntryFromROB(robTable);
+
+            // the instruction has committed, return it to the instruction pool
+            releaseInstruction(decodeUnit->instPool, robStatusEntry->inst);
+            robStatusEntry->inst = NULL;
         }
     }
 }
\ No newline at end of file
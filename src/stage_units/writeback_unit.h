@@ -1,6 +1,5 @@
 
 // forward declarations
-typedef struct ResStationStatusTableEntry ResStationStatusTableEntry;
 typedef struct StatusTables StatusTables;
 typedef struct FunctionalUnits FunctionalUnits;
 typedef struct DecodeUnit DecodeUnit;
@@ -9,6 +8,9 @@ typedef struct MemoryUnit MemoryUnit;
 typedef struct DataCache DataCache;
 typedef struct FetchUnit FetchUnit;
 typedef struct StallStats StallStats;
+typedef struct ROBStatusTable ROBStatusTable;
+typedef struct ResStationStatusTable ResStationStatusTable;
+typedef struct FPFunctionalUnit FPFunctionalUnit;
 
 // struct representing a common data bus
 typedef struct CDB {
@@ -19,6 +21,7 @@ typedef struct CDB {
     int destPhysReg;
     int producedBy;
     int producingFUType;
+    int producingFUIndex; // index of the producing unit among the units of its type, -1 if not from a functional unit
     int buTookBranch;
     int addr;
 } CDB;
@@ -32,6 +35,7 @@ typedef struct ROBWBInfo {
     int numOperandsWaiting;
     int producedBy; // enum ValProducedBy
     int producingFUType; // enum FunctionalUnitType
+    int producingFUIndex;
     int valueType; // enum InstructionResultValueType
     int addr;
 
@@ -46,14 +50,28 @@ typedef struct WritebackUnit {
     int NB;
     int NR;
 
+    // ROB indices of the functional unit results ready this cycle, the first readyResultsHeapSize of them form a heap ordered by CDB priority
+    int *readyResults;
+    int numReadyResults;
+    int readyResultsHeapSize;
+
+    int numCommittedInsts;
+
 } WritebackUnit;
 
 // writeback unit methods
 void initWritebackUnit(WritebackUnit *writebackUnit, int NB, int NR);
 void teardownWritebackUnit(WritebackUnit *writebackUnit);
 void resetWritebackUnitROBWBInfo(WritebackUnit *writebackUnit);
-void updateWritebackUnitWaitingForROB(WritebackUnit *writebackUnit, ResStationStatusTableEntry **resStationEntries, int numEntries);
+void addReadyResultToWritebackUnit(WritebackUnit *writebackUnit, int robIndex);
+int readyResultHasPriority(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int robA, int robB);
+void siftUpReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int pos);
+void siftDownReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable, int pos);
+void buildReadyResultHeap(WritebackUnit *writebackUnit, ROBStatusTable *robTable, ResStationStatusTable *resStationTable);
+int popReadyResult(WritebackUnit *writebackUnit, ROBStatusTable *robTable);
+void addFPFunctionalUnitResultsToROBWBInfo(WritebackUnit *writebackUnit, FPFunctionalUnit *fpFUs, int numFPFUs);
+void flushInstructionsAfterROBHead(FetchUnit *fetchUnit, DecodeUnit *decodeUnit, MemoryUnit *memUnit, StatusTables *statusTables, FunctionalUnits *functionalUnits);
 void cycleWritebackUnit(WritebackUnit *writebackUnit, FetchUnit *fetchUnit, DecodeUnit *decodeUnit, MemoryUnit *memUnit, StatusTables *statusTables, 
-    FunctionalUnits *functionalUnits, RegisterFile *registerFile, DataCache *dataCache, BranchPredictor *branchPredictor, StallStats *stallStats);
+    FunctionalUnits *functionalUnits, RegisterFile *registerFile, DataCache *dataCache, BranchPredictor *branchPredictor, StallStats *stallStats, int cycle);
 void printWritebackUnitROBInfo(WritebackUnit *writebackUnit);
 void printWritebackUnitCDBs(WritebackUnit *writebackUnit);
@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../misc/misc.h"
+#include "load_store_queue.h"
+
+// initialize the load/store queue struct, every ROB entry could hold a load or a store so neither queue can fill up before the ROB does
+void initLoadStoreQueue(LoadStoreQueue *lsq, Params *params) {
+
+    initMemoryOpQueue(&lsq->loadQueue, params->NR);
+    initMemoryOpQueue(&lsq->storeQueue, params->NR);
+
+    lsq->queueIndexForROB = malloc(params->NR * sizeof(int));
+    for (int i = 0; i < params->NR; i++) {
+        lsq->queueIndexForROB[i] = -1;
+    }
+
+    // 0 is kept to mean no store
+    lsq->nextSeqNum = 1;
+
+    initStoreSetPredictor(&lsq->storeSets, params->ssitSize, params->numStoreSets);
+
+    lsq->numForwardedLoads = 0;
+    lsq->numPredictedLoads = 0;
+    lsq->numOrderingViolations = 0;
+}
+
+// free any load/store queue struct elements that are stored on the heap
+void teardownLoadStoreQueue(LoadStoreQueue *lsq) {
+
+    teardownMemoryOpQueue(&lsq->loadQueue);
+    teardownMemoryOpQueue(&lsq->storeQueue);
+
+    if (lsq->queueIndexForROB) {
+        free(lsq->queueIndexForROB);
+    }
+
+    teardownStoreSetPredictor(&lsq->storeSets);
+}
+
+// initialize an empty load or store queue
+void initMemoryOpQueue(MemoryOpQueue *queue, int capacity) {
+    queue->entries = malloc(capacity * sizeof(LoadStoreQueueEntry));
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->count = 0;
+
+    // use at least as many buckets as there can be entries so chains stay short
+    queue->numBuckets = 1;
+    queue->bucketShift = 32;
+    while (queue->numBuckets < capacity) {
+        queue->numBuckets *= 2;
+        queue->bucketShift--;
+    }
+
+    queue->buckets = malloc(queue->numBuckets * sizeof(int));
+    for (int i = 0; i < queue->numBuckets; i++) {
+        queue->buckets[i] = -1;
+    }
+}
+
+// free any elements of a load or store queue that are stored on the heap
+void teardownMemoryOpQueue(MemoryOpQueue *queue) {
+    if (queue->entries) {
+        free(queue->entries);
+    }
+    if (queue->buckets) {
+        free(queue->buckets);
+    }
+}
+
+// returns the load queue or the store queue depending on the type of instruction
+MemoryOpQueue *memoryOpQueueForFunctionalUnit(LoadStoreQueue *lsq, int fuType) {
+    return fuType == FU_TYPE_LOAD ? &lsq->loadQueue : &lsq->storeQueue;
+}
+
+// returns the load or store queue entry of the instruction in a given ROB entry
+LoadStoreQueueEntry *loadStoreQueueEntryForROB(LoadStoreQueue *lsq, int robIndex, int fuType) {
+    return &memoryOpQueueForFunctionalUnit(lsq, fuType)->entries[lsq->queueIndexForROB[robIndex]];
+}
+
+// returns the bucket that a given address hashes to
+int memoryOpQueueBucketForAddress(MemoryOpQueue *queue, int addr) {
+
+    if (queue->numBuckets == 1) {
+        return 0;
+    }
+
+    // fibonacci hashing, the upper bits of the product depend on every bit of the address
+    return (int) (((unsigned int) addr * 2654435769u) >> queue->bucketShift);
+}
+
+// adds an entry whose address just became known to the chain of its address bucket
+void linkMemoryOpQueueEntryToBucket(MemoryOpQueue *queue, int index) {
+
+    LoadStoreQueueEntry *entry = &queue->entries[index];
+    int bucket = memoryOpQueueBucketForAddress(queue, entry->addr);
+
+    entry->nextInBucket = queue->buckets[bucket];
+    queue->buckets[bucket] = index;
+}
+
+// removes an entry from the chain of its address bucket
+void unlinkMemoryOpQueueEntryFromBucket(MemoryOpQueue *queue, int index) {
+
+    LoadStoreQueueEntry *entry = &queue->entries[index];
+    int *link = &queue->buckets[memoryOpQueueBucketForAddress(queue, entry->addr)];
+
+    while (*link != -1 && *link != index) {
+        link = &queue->entries[*link].nextInBucket;
+    }
+
+    if (*link == index) {
+        *link = entry->nextInBucket;
+    }
+}
+
+// adds a load or store to the tail of its queue when it is issued. a load in a store set is made to wait for the last
+// store of its set that was issued before it, and a store in a store set becomes the one later loads wait for
+void addInstToLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int fuType, int pc) {
+
+    MemoryOpQueue *queue = memoryOpQueueForFunctionalUnit(lsq, fuType);
+
+    // this method assumes that the queue was not full, which the ROB guarantees
+    int index = queue->tail;
+    LoadStoreQueueEntry *entry = &queue->entries[index];
+
+    queue->tail = (queue->tail + 1) % queue->capacity;
+    queue->count++;
+
+    entry->robIndex = robIndex;
+    entry->pc = pc;
+    entry->seqNum = lsq->nextSeqNum++;
+    entry->addr = -1;
+    entry->value = 0;
+    entry->nextInBucket = -1;
+    entry->forwardedFromSeqNum = 0;
+    entry->predictedStoreIndex = -1;
+    entry->predictedStoreSeqNum = 0;
+    entry->violatingStorePC = -1;
+
+    lsq->queueIndexForROB[robIndex] = index;
+
+    if (fuType == FU_TYPE_LOAD) {
+        LFSTEntry *lastStore = lastFetchedStoreForPC(&lsq->storeSets, pc);
+
+        if (lastStore && lastStore->storeIndex != -1) {
+            entry->predictedStoreIndex = lastStore->storeIndex;
+            entry->predictedStoreSeqNum = lastStore->seqNum;
+            lsq->numPredictedLoads++;
+        }
+    } else {
+        setLastFetchedStore(&lsq->storeSets, pc, index, entry->seqNum);
+    }
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("added ROB: %i to %s queue entry: %i, seqNum: %u, predicted store: %i\n", robIndex, fuType == FU_TYPE_LOAD ? "load" : "store", index, entry->seqNum,
+        entry->predictedStoreIndex);
+    #endif
+}
+
+// returns 1 if the load in a given ROB entry was predicted to depend on a store whose address is not known yet
+int loadIsWaitingForPredictedStore(LoadStoreQueue *lsq, int robIndex) {
+
+    LoadStoreQueueEntry *entry = loadStoreQueueEntryForROB(lsq, robIndex, FU_TYPE_LOAD);
+    if (entry->predictedStoreIndex == -1) {
+        return 0;
+    }
+
+    // the store has executed once its address is known, and it has committed if its entry was reused
+    LoadStoreQueueEntry *store = &lsq->storeQueue.entries[entry->predictedStoreIndex];
+    return store->seqNum == entry->predictedStoreSeqNum && store->addr == -1;
+}
+
+// returns the youngest store older than a given load that writes to the load's address, NULL if there is none
+LoadStoreQueueEntry *forwardingStoreForLoad(LoadStoreQueue *lsq, int loadROBIndex, int addr) {
+
+    unsigned int loadSeqNum = loadStoreQueueEntryForROB(lsq, loadROBIndex, FU_TYPE_LOAD)->seqNum;
+    MemoryOpQueue *storeQueue = &lsq->storeQueue;
+
+    LoadStoreQueueEntry *youngestOlderStore = NULL;
+
+    // only stores in the same bucket can have the same address
+    for (int i = storeQueue->buckets[memoryOpQueueBucketForAddress(storeQueue, addr)]; i != -1; i = storeQueue->entries[i].nextInBucket) {
+        LoadStoreQueueEntry *entry = &storeQueue->entries[i];
+
+        if (entry->addr == addr && entry->seqNum < loadSeqNum && (!youngestOlderStore || entry->seqNum > youngestOlderStore->seqNum)) {
+            youngestOlderStore = entry;
+        }
+    }
+
+    return youngestOlderStore;
+}
+
+// records the address of a load once it reaches the memory unit, along with the store its value is forwarded from (NULL for the data cache)
+void setLoadAddressInLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int addr, LoadStoreQueueEntry *forwardingStore) {
+
+    int loadIndex = lsq->queueIndexForROB[robIndex];
+    LoadStoreQueueEntry *entry = &lsq->loadQueue.entries[loadIndex];
+
+    // a load retried by the memory unit is only added to its bucket once
+    if (entry->addr == -1) {
+        entry->addr = addr;
+        linkMemoryOpQueueEntryToBucket(&lsq->loadQueue, loadIndex);
+    }
+
+    entry->forwardedFromSeqNum = forwardingStore ? forwardingStore->seqNum : 0;
+}
+
+// records the address and value of a store once it reaches the memory unit, making it visible to younger loads. younger loads
+// to the same address that already got a value from the data cache or from a store older than this one read a stale value
+void setStoreAddressInLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int addr, float value) {
+
+    int storeIndex = lsq->queueIndexForROB[robIndex];
+    LoadStoreQueueEntry *entry = &lsq->storeQueue.entries[storeIndex];
+
+    entry->addr = addr;
+    entry->value = value;
+    linkMemoryOpQueueEntryToBucket(&lsq->storeQueue, storeIndex);
+
+    // loads of the store set no longer have to wait for this store
+    clearLastFetchedStore(&lsq->storeSets, entry->pc, storeIndex, entry->seqNum);
+
+    #ifdef ENABLE_DEBUG_LOG
+    printf("store queue entry: %i for ROB: %i has address: %i and value: %f\n", storeIndex, robIndex, addr, value);
+    #endif
+
+    MemoryOpQueue *loadQueue = &lsq->loadQueue;
+
+    for (int i = loadQueue->buckets[memoryOpQueueBucketForAddress(loadQueue, addr)]; i != -1; i = loadQueue->entries[i].nextInBucket) {
+        LoadStoreQueueEntry *load = &loadQueue->entries[i];
+
+        if (load->addr == addr && load->seqNum > entry->seqNum && load->forwardedFromSeqNum < entry->seqNum && load->violatingStorePC == -1) {
+            #ifdef ENABLE_DEBUG_LOG
+            printf("load for ROB: %i read address: %i before the older store for ROB: %i resolved, it will be squashed when it commits\n", load->robIndex, addr, robIndex);
+            #endif
+
+            load->violatingStorePC = entry->pc;
+            trainStoreSetPredictor(&lsq->storeSets, load->pc, entry->pc);
+        }
+    }
+}
+
+// removes the oldest load or store from its queue when it commits
+void removeHeadFromLoadStoreQueue(LoadStoreQueue *lsq, int fuType) {
+
+    MemoryOpQueue *queue = memoryOpQueueForFunctionalUnit(lsq, fuType);
+    LoadStoreQueueEntry *entry = &queue->entries[queue->head];
+
+    #ifdef ENABLE_DEBUG_LOG
+    if (queue->count == 0) {
+        printf("error: removing the head of an empty %s queue, this shouldn't happen...\n", fuType == FU_TYPE_LOAD ? "load" : "store");
+    }
+    #endif
+
+    if (entry->addr != -1) {
+        unlinkMemoryOpQueueEntryFromBucket(queue, queue->head);
+    }
+
+    lsq->queueIndexForROB[entry->robIndex] = -1;
+
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+}
+
+// flushes every load and store from the queues
+void flushLoadStoreQueue(LoadStoreQueue *lsq) {
+
+    MemoryOpQueue *queues[2] = {&lsq->loadQueue, &lsq->storeQueue};
+
+    for (int i = 0; i < 2; i++) {
+        MemoryOpQueue *queue = queues[i];
+
+        for (int j = 0; j < queue->count; j++) {
+            lsq->queueIndexForROB[queue->entries[(queue->head + j) % queue->capacity].robIndex] = -1;
+        }
+
+        queue->head = 0;
+        queue->tail = 0;
+        queue->count = 0;
+
+        for (int j = 0; j < queue->numBuckets; j++) {
+            queue->buckets[j] = -1;
+        }
+    }
+
+    flushLastFetchedStores(&lsq->storeSets);
+}
+
+// prints the contents of the load and store queues, oldest first
+void printLoadStoreQueue(LoadStoreQueue *lsq) {
+
+    MemoryOpQueue *queues[2] = {&lsq->loadQueue, &lsq->storeQueue};
+
+    for (int i = 0; i < 2; i++) {
+        MemoryOpQueue *queue = queues[i];
+
+        printf("%s queue: head: %i, count: %i\n", i == 0 ? "load" : "store", queue->head, queue->count);
+
+        for (int j = 0; j < queue->count; j++) {
+            LoadStoreQueueEntry *entry = &queue->entries[(queue->head + j) % queue->capacity];
+            printf("\trobIndex: %i, pc: %i, seqNum: %u, addr: %i, value: %f", entry->robIndex, entry->pc, entry->seqNum, entry->addr, entry->value);
+
+            if (i == 0) {
+                printf(", forwardedFromSeqNum: %u, predictedStoreIndex: %i, violatingStorePC: %i", entry->forwardedFromSeqNum, entry->predictedStoreIndex, entry->violatingStorePC);
+            }
+
+            printf("\n");
+        }
+    }
+}
+
+// prints the statistics collected by the load/store queue
+void printLoadStoreQueueStats(LoadStoreQueue *lsq) {
+    printf("\nload/store queue statistics:\n");
+    printf("\tloads forwarded from older stores: %i\n", lsq->numForwardedLoads);
+    printf("\tloads held for a predicted store: %i\n", lsq->numPredictedLoads);
+    printf("\tmemory ordering violations: %i\n", lsq->numOrderingViolations);
+}
@@ -0,0 +1,71 @@
+#include "../memory_dependence/store_set_predictor.h"
+
+// forward declarations
+typedef struct Params Params;
+
+// struct representing an entry in the load queue or the store queue
+typedef struct LoadStoreQueueEntry {
+    int robIndex;
+    int pc; // address of the instruction, used to train the store set predictor
+    unsigned int seqNum; // position in program order, counted across both queues
+    int addr; // -1 until the load or store reaches the memory unit with its calculated address
+    float value; // the value written by a store
+    int nextInBucket; // next entry of the same queue in the same address bucket, -1 at the end of the chain
+
+    // only used by loads
+    unsigned int forwardedFromSeqNum; // sequence number of the store the value was forwarded from, 0 if it came from the data cache
+    int predictedStoreIndex; // store queue entry the store set predictor made the load wait for, -1 if none
+    unsigned int predictedStoreSeqNum;
+    int violatingStorePC; // address of an older store to the same address that resolved after the load got its value, -1 if none
+} LoadStoreQueueEntry;
+
+// struct representing a circular buffer of loads or stores, allocated at the tail in program order and removed from the head
+// as they commit. entries with known addresses are also chained by a hash of the address
+typedef struct MemoryOpQueue {
+    LoadStoreQueueEntry *entries;
+    int capacity;
+    int head;
+    int tail;
+    int count;
+
+    int *buckets; // first entry of each address bucket, -1 if the bucket is empty
+    int numBuckets; // power of 2
+    int bucketShift;
+} MemoryOpQueue;
+
+// struct representing the load and store queues
+typedef struct LoadStoreQueue {
+    MemoryOpQueue loadQueue;
+    MemoryOpQueue storeQueue;
+
+    // for each ROB entry holding a load or store, the index of its entry in the load or store queue
+    int *queueIndexForROB;
+
+    unsigned int nextSeqNum;
+
+    StoreSetPredictor storeSets;
+
+    int numForwardedLoads;
+    int numPredictedLoads; // loads issued while the last store of their store set was in flight
+    int numOrderingViolations; // loads squashed because they read their value before an older store to the same address
+} LoadStoreQueue;
+
+// load/store queue methods
+void initLoadStoreQueue(LoadStoreQueue *lsq, Params *params);
+void teardownLoadStoreQueue(LoadStoreQueue *lsq);
+void initMemoryOpQueue(MemoryOpQueue *queue, int capacity);
+void teardownMemoryOpQueue(MemoryOpQueue *queue);
+MemoryOpQueue *memoryOpQueueForFunctionalUnit(LoadStoreQueue *lsq, int fuType); // fuType = enum FunctionalUnitType
+LoadStoreQueueEntry *loadStoreQueueEntryForROB(LoadStoreQueue *lsq, int robIndex, int fuType); // fuType = enum FunctionalUnitType
+int memoryOpQueueBucketForAddress(MemoryOpQueue *queue, int addr);
+void linkMemoryOpQueueEntryToBucket(MemoryOpQueue *queue, int index);
+void unlinkMemoryOpQueueEntryFromBucket(MemoryOpQueue *queue, int index);
+void addInstToLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int fuType, int pc); // fuType = enum FunctionalUnitType
+int loadIsWaitingForPredictedStore(LoadStoreQueue *lsq, int robIndex);
+LoadStoreQueueEntry *forwardingStoreForLoad(LoadStoreQueue *lsq, int loadROBIndex, int addr);
+void setLoadAddressInLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int addr, LoadStoreQueueEntry *forwardingStore);
+void setStoreAddressInLoadStoreQueue(LoadStoreQueue *lsq, int robIndex, int addr, float value);
+void removeHeadFromLoadStoreQueue(LoadStoreQueue *lsq, int fuType); // fuType = enum FunctionalUnitType
+void flushLoadStoreQueue(LoadStoreQueue *lsq);
+void printLoadStoreQueue(LoadStoreQueue *lsq);
+void printLoadStoreQueueStats(LoadStoreQueue *lsq);
@@ -7,6 +7,7 @@
 #include "../functional_units/functional_units.h"
 #include "register_table.h"
 #include "res_station_table.h"
+#include "rob_table.h"
 
 // returns a new reservation station status table entry allocated on the heap
 ResStationStatusTableEntry *newResStationStatusTableEntry() {
@@ -29,20 +30,32 @@ ResStationStatusTableEntry *newResStationStatusTableEntry() {
     entry->addr = -1;
     entry->buOffset = 0;
 
+    for (int i = 0; i < 2; i++) {
+        entry->operandWaiters[i].entry = entry;
+        entry->operandWaiters[i].sourceNum = i + 1;
+        entry->operandWaiters[i].next = NULL;
+    }
+
     return entry;
 }
 
 // initialize the reservation station status table
-void initResStationStatusTable(ResStationStatusTable *resStationTable) {
+void initResStationStatusTable(ResStationStatusTable *resStationTable, Params *params) {
 
     // declare the number of res stations for each functional unit
-    resStationTable->numIntStations = 4;
-    resStationTable->numLoadStations = 2;
-    resStationTable->numStoreStations = 2;
-    resStationTable->numFPAddStations = 3;
-    resStationTable->numFPMulStations = 3;
-    resStationTable->numFPDivStations = 2;
-    resStationTable->numBUStations = 2;
+    resStationTable->numIntStations = params->numIntStations;
+    resStationTable->numLoadStations = params->numLoadStations;
+    resStationTable->numStoreStations = params->numStoreStations;
+    resStationTable->numFPAddStations = params->numFPAddStations;
+    resStationTable->numFPMulStations = params->numFPMulStations;
+    resStationTable->numFPDivStations = params->numFPDivStations;
+    resStationTable->numBUStations = params->numBUStations;
+
+    resStationTable->lastSelectedIntStation = -1;
+    resStationTable->lastSelectedFPAddStation = -1;
+    resStationTable->lastSelectedFPMulStation = -1;
+    resStationTable->lastSelectedFPDivStation = -1;
+    resStationTable->lastSelectedBUStation = -1;
 
     // allocate arrays to store reservation station status table entries for each functional unit
     resStationTable->intEntries = malloc(resStationTable->numIntStations * sizeof(ResStationStatusTableEntry *));
@@ -122,6 +135,10 @@ void initResStationStatusTable(ResStationStatusTable *resStationTable) {
 
         resStationTable->buEntries[i] = entry;
     }
+
+    // no operands are waiting on any ROB entries
+    resStationTable->NR = params->NR;
+    resStationTable->operandWaitersForROB = calloc(params->NR, sizeof(ResStationOperandWaiter *));
 }
 
 // free any data elements of the reservation status table that are stored on the heap
@@ -174,6 +191,10 @@ void teardownResStationStatusTable(ResStationStatusTable *resStationTable) {
         }
         free(resStationTable->buEntries);
     }
+
+    if (resStationTable->operandWaitersForROB) {
+        free(resStationTable->operandWaitersForROB);
+    }
 }
 
 // returns the number of reservation stations for a given functional unit
@@ -195,7 +216,7 @@ int numResStationsForFunctionalUnit(ResStationStatusTable *resStationTable, int
         return resStationTable->numBUStations;
     } else {
         printf_DEBUG(("error: invalid FunctionalUnitType used while getting number of reservation stations...\n"));
-        exit(1);
+        exitSimulation(1);
     }
 }
 
@@ -218,7 +239,26 @@ ResStationStatusTableEntry **resStationEntriesForFunctionalUnit(ResStationStatus
         return resStationTable->buEntries;
     } else {
         printf_DEBUG(("error: invalid FunctionalUnitType used while get reservation station entries array...\n"));
-        exit(1);
+        exitSimulation(1);
+    }
+}
+
+// returns the round robin position of the reservation stations for a given functional unit, which its units update as they select stations
+int *lastSelectedResStationForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType) {
+
+    if (fuType == FU_TYPE_INT) {
+        return &resStationTable->lastSelectedIntStation;
+    } else if (fuType == FU_TYPE_FPADD) {
+        return &resStationTable->lastSelectedFPAddStation;
+    } else if (fuType == FU_TYPE_FPMUL) {
+        return &resStationTable->lastSelectedFPMulStation;
+    } else if (fuType == FU_TYPE_FPDIV) {
+        return &resStationTable->lastSelectedFPDivStation;
+    } else if (fuType == FU_TYPE_BU) {
+        return &resStationTable->lastSelectedBUStation;
+    } else {
+        printf_DEBUG(("error: invalid FunctionalUnitType used while getting the last selected reservation station...\n"));
+        exitSimulation(1);
     }
 }
 
@@ -257,11 +297,11 @@ ResStationStatusTableEntry **resStationEntriesForInstruction(ResStationStatusTab
         return resStationTable->fpMulEntries;
     } else if (instType == FDIV) {
         return resStationTable->fpDivEntries;
-    } else if (instType == BNE) {
+    } else if (instTypeIsBranchOrJump(instType)) {
         return resStationTable->buEntries;
     } else {
         printf_DEBUG(("got invalid instruction type while trying to get the reservation station entry array for an instruction, this should never happen..."));
-        exit(1);
+        exitSimulation(1);
     }
 }
 
@@ -302,11 +342,11 @@ int indexForFreeResStationForInstruction(ResStationStatusTable *resStationTable,
         return indexForFreeResStation(resStationTable, FU_TYPE_FPMUL);
     } else if (instType == FDIV) {
         return indexForFreeResStation(resStationTable, FU_TYPE_FPDIV);
-    } else if (instType == BNE) {
+    } else if (instTypeIsBranchOrJump(instType)) {
         return indexForFreeResStation(resStationTable, FU_TYPE_BU);
     } else {
         printf_DEBUG(("got invalid instruction type while trying to get the index of a free reservation station, this should never happen..."));
-        exit(1);
+        exitSimulation(1);
     }
 
     return -1;
@@ -336,9 +376,17 @@ int numBusyResStationsForFunctionalUnit(ResStationStatusTable *resStationTable,
     return numBusyStations;
 }
 
+// adds an operand of a reservation station to the list of operands waiting on the result of a given ROB entry
+void addOperandWaiterForROB(ResStationStatusTable *resStationTable, ResStationStatusTableEntry *entry, int sourceNum, int robIndex) {
+
+    ResStationOperandWaiter *waiter = &entry->operandWaiters[sourceNum - 1];
+    waiter->next = resStationTable->operandWaitersForROB[robIndex];
+    resStationTable->operandWaitersForROB[robIndex] = waiter;
+}
+
 // helper method to set the availability of a given operand in a reservation station status table entry
-void setResStationEntryOperandAvailability(ResStationStatusTableEntry *entry, RegisterStatusTable *regTable, RegisterFile *regFile, 
-    int sourceNum, ArchRegister *reg, enum PhysicalRegisterName renamedReg, int resultType) {
+void setResStationEntryOperandAvailability(ResStationStatusTable *resStationTable, ResStationStatusTableEntry *entry, RegisterStatusTable *regTable, 
+    RegisterFile *regFile, int sourceNum, ArchRegister *reg, enum PhysicalRegisterName renamedReg, int resultType) {
 
     // get the current ROB that will write to the source architecture register
     int robIndex = getRegisterStatusTableEntryROBIndex(regTable, reg);
@@ -371,6 +419,8 @@ void setResStationEntryOperandAvailability(ResStationStatusTableEntry *entry, Re
             entry->vkIsAvailable = 0;
             entry->qk = robIndex;
         }
+
+        addOperandWaiterForROB(resStationTable, entry, sourceNum, robIndex);
     }
 }
 
@@ -393,7 +443,7 @@ void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusT
             entry->op = FU_OP_ADD;
 
             // read first operand from register file or set source ROB 
-            setResStationEntryOperandAvailability(entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
+            setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
 
             // manually do the second operand since its value is available within the instruction itself
             entry->vkInt = inst->imm;
@@ -405,8 +455,8 @@ void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusT
             entry->op = instType == ADD ? FU_OP_ADD : FU_OP_SLT;
 
             // read operands from register file or set source ROB 
-            setResStationEntryOperandAvailability(entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
-            setResStationEntryOperandAvailability(entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
+            setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
+            setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
         }
 
     // add instructions that need the FPAdd functional unit to the reservation station
@@ -418,14 +468,14 @@ void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusT
         }
 
         // read operands from register file or set source ROB 
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_FLOAT);
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_FLOAT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_FLOAT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_FLOAT);
     
     // add instructions that need the load functional unit to the reservation station
     } else if (instType == FLD) {
 
         entry->addr = inst->imm;
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
 
     // add instructions that need the store functional unit to the reservation station
     } else if (instType == FSD) {
@@ -433,17 +483,32 @@ void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusT
         // in reality stores use the destination field but having it be the source 2 simplified things for implementing this
 
         entry->addr = inst->imm;
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_FLOAT);
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_FLOAT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
     
     // add instructions that need the BU functional unit to the reservation station
     } else if (instType == BNE) {
 
+        entry->op = FU_OP_BNE;
+        entry->buOffset = inst->imm;
+        entry->addr = inst->addr;
+
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
+        setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
+
+    // jumps also use the BU functional unit, jal needs no operands and jalr only needs the register holding its target
+    } else if (instType == JAL || instType == JALR) {
+
+        entry->op = instType == JAL ? FU_OP_JAL : FU_OP_JALR;
         entry->buOffset = inst->imm;
         entry->addr = inst->addr;
 
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
-        setResStationEntryOperandAvailability(entry, regTable, regFile, 2, inst->source2Reg, inst->source2PhysReg, VALUE_TYPE_INT);
+        if (instType == JALR) {
+            setResStationEntryOperandAvailability(resStationTable, entry, regTable, regFile, 1, inst->source1Reg, inst->source1PhysReg, VALUE_TYPE_INT);
+        } else {
+            entry->vjIsAvailable = 1;
+        }
+        entry->vkIsAvailable = 1;
     }
 
     #ifdef ENABLE_DEBUG_LOG
@@ -451,67 +516,61 @@ void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusT
     #endif
 }
 
-// helper method to process int updates for any list of reservation station status table entries
-void processIntUpdateForResStationEntries(ResStationStatusTableEntry **entries, int numEntries, int destROB, int result, int fromCDB) {
+// helper method to deliver an int result to a reservation station operand that was waiting on it
+void processIntUpdateForResStationOperand(ResStationOperandWaiter *waiter, int destROB, int result, int fromCDB) {
 
-    // iterate over all entries of the reservation station
-    for (int i = 0; i < numEntries; i++) {
-        ResStationStatusTableEntry *entry = entries[i];
+    ResStationStatusTableEntry *entry = waiter->entry;
 
-        // only update the entry's operands if they are currently available and the result ROB matches the source ROB
-        if (entry->busy && !entry->vjIsAvailable && entry->qj == destROB) {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("reservation station index: %i received int value: %i for vj\n", entry->resStationIndex, result);
-            #endif
+    // only update the entry's operands if they are currently available and the result ROB matches the source ROB
+    if (waiter->sourceNum == 1 && entry->busy && !entry->vjIsAvailable && entry->qj == destROB) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("reservation station index: %i received int value: %i for vj\n", entry->resStationIndex, result);
+        #endif
 
-            entry->vjIsAvailable = 1;
-            entry->vjInt = result;
-            entry->qj = -1;
-            entry->justGotOperandFromCDB = fromCDB;
-        }
+        entry->vjIsAvailable = 1;
+        entry->vjInt = result;
+        entry->qj = -1;
+        entry->justGotOperandFromCDB = fromCDB;
+    }
 
-        if (entry->busy && !entry->vkIsAvailable && entry->qk == destROB) {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("reservation station index: %i received int value: %i for vk\n", entry->resStationIndex, result);
-            #endif
+    if (waiter->sourceNum == 2 && entry->busy && !entry->vkIsAvailable && entry->qk == destROB) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("reservation station index: %i received int value: %i for vk\n", entry->resStationIndex, result);
+        #endif
 
-            entry->vkIsAvailable = 1;
-            entry->vkInt = result;
-            entry->qk = -1;
-            entry->justGotOperandFromCDB = fromCDB;
-        }
+        entry->vkIsAvailable = 1;
+        entry->vkInt = result;
+        entry->qk = -1;
+        entry->justGotOperandFromCDB = fromCDB;
     }
 }
 
-// helper method to process float updates for any list of reservation station status table entries
-void processFloatUpdateForResStationEntries(ResStationStatusTableEntry **entries, int numEntries, int destROB, float result, int fromCDB) {
+// helper method to deliver a float result to a reservation station operand that was waiting on it
+void processFloatUpdateForResStationOperand(ResStationOperandWaiter *waiter, int destROB, float result, int fromCDB) {
 
-    // iterate over the reservation station entries
-    for (int i = 0; i < numEntries; i++) {
-        ResStationStatusTableEntry *entry = entries[i];
+    ResStationStatusTableEntry *entry = waiter->entry;
 
-        // only update the entry's operands if they are currently available and the result ROB matches the source ROB
-        if (entry->busy && !entry->vjIsAvailable && entry->qj == destROB) {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("reservation station index: %i received float value: %f for vj\n", entry->resStationIndex, result);
-            #endif
+    // only update the entry's operands if they are currently available and the result ROB matches the source ROB
+    if (waiter->sourceNum == 1 && entry->busy && !entry->vjIsAvailable && entry->qj == destROB) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("reservation station index: %i received float value: %f for vj\n", entry->resStationIndex, result);
+        #endif
 
-            entry->vjIsAvailable = 1;
-            entry->vjFloat = result;
-            entry->qj = -1;
-            entry->justGotOperandFromCDB = fromCDB;
-        }
+        entry->vjIsAvailable = 1;
+        entry->vjFloat = result;
+        entry->qj = -1;
+        entry->justGotOperandFromCDB = fromCDB;
+    }
 
-        if (entry->busy && !entry->vkIsAvailable && entry->qk == destROB) {
-            #ifdef ENABLE_DEBUG_LOG
-            printf("reservation station index: %i received forwarded float: %f for vk\n", entry->resStationIndex, result);
-            #endif
+    if (waiter->sourceNum == 2 && entry->busy && !entry->vkIsAvailable && entry->qk == destROB) {
+        #ifdef ENABLE_DEBUG_LOG
+        printf("reservation station index: %i received forwarded float: %f for vk\n", entry->resStationIndex, result);
+        #endif
 
-            entry->vkIsAvailable = 1;
-            entry->vkFloat = result;
-            entry->qk = -1;
-            entry->justGotOperandFromCDB = fromCDB;
-        }
+        entry->vkIsAvailable = 1;
+        entry->vkFloat = result;
+        entry->qk = -1;
+        entry->justGotOperandFromCDB = fromCDB;
     }
 }
 
@@ -522,11 +581,24 @@ void sendIntUpdateToResStationStatusTable(ResStationStatusTable *resStationTable
     printf("sending int result: %i robIndex: %i to reservation stations\n", result, destROB);
     #endif
 
-    // forward int result to reservation stations that can use int registers
-    processIntUpdateForResStationEntries(resStationTable->intEntries, resStationTable->numIntStations, destROB, result, fromCDB);
-    processIntUpdateForResStationEntries(resStationTable->loadEntries, resStationTable->numLoadStations, destROB, result, fromCDB);
-    processIntUpdateForResStationEntries(resStationTable->storeEntries, resStationTable->numStoreStations, destROB, result, fromCDB);
-    processIntUpdateForResStationEntries(resStationTable->buEntries, resStationTable->numBUStations, destROB, result, fromCDB);
+    // every operand waiting on the ROB receives the result, so the list is emptied
+    ResStationOperandWaiter *waiter = resStationTable->operandWaitersForROB[destROB];
+    resStationTable->operandWaitersForROB[destROB] = NULL;
+
+    for (; waiter; waiter = waiter->next) {
+        processIntUpdateForResStationOperand(waiter, destROB, result, fromCDB);
+    }
+}
+
+// returns the number of reservation station operands waiting on the result of a given ROB entry
+int numOperandsWaitingForROB(ResStationStatusTable *resStationTable, int robIndex) {
+
+    int numWaiting = 0;
+    for (ResStationOperandWaiter *waiter = resStationTable->operandWaitersForROB[robIndex]; waiter; waiter = waiter->next) {
+        numWaiting++;
+    }
+
+    return numWaiting;
 }
 
 // updates the operands of reservation stations waiting for a float value
@@ -536,13 +608,13 @@ void sendFloatUpdateToResStationStatusTable(ResStationStatusTable *resStationTab
     printf("sending float result: %f robIndex: %i to reservation stations\n", result, destROB);
     #endif
 
-    // forward int result to reservation stations that can use int registers
-    processFloatUpdateForResStationEntries(resStationTable->loadEntries, resStationTable->numLoadStations, destROB, result, fromCDB);
-    processFloatUpdateForResStationEntries(resStationTable->storeEntries, resStationTable->numStoreStations, destROB, result, fromCDB);
-    processFloatUpdateForResStationEntries(resStationTable->buEntries, resStationTable->numBUStations, destROB, result, fromCDB);
-    processFloatUpdateForResStationEntries(resStationTable->fpAddEntries, resStationTable->numFPAddStations, destROB, result, fromCDB);
-    processFloatUpdateForResStationEntries(resStationTable->fpMulEntries, resStationTable->numFPMulStations, destROB, result, fromCDB);
-    processFloatUpdateForResStationEntries(resStationTable->fpDivEntries, resStationTable->numFPDivStations, destROB, result, fromCDB);
+    // every operand waiting on the ROB receives the result, so the list is emptied
+    ResStationOperandWaiter *waiter = resStationTable->operandWaitersForROB[destROB];
+    resStationTable->operandWaitersForROB[destROB] = NULL;
+
+    for (; waiter; waiter = waiter->next) {
+        processFloatUpdateForResStationOperand(waiter, destROB, result, fromCDB);
+    }
 }
 
 // prints the contents of the reservation station status table
@@ -660,4 +732,50 @@ void flushResStationStatusTable(ResStationStatusTable *resStationTable) {
         ResStationStatusTableEntry *entry = resStationTable->storeEntries[i];
         entry->busy = 0;
     }
+
+    // no operands are waiting on ROB entries anymore
+    for (int i = 0; i < resStationTable->NR; i++) {
+        resStationTable->operandWaitersForROB[i] = NULL;
+    }
+}
+
+// lets reservation stations of a given functional unit that received an operand from the CDB in an earlier cycle start executing
+void clearJustGotOperandFromCDBForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType) {
+
+    ResStationStatusTableEntry **entries = resStationEntriesForFunctionalUnit(resStationTable, fuType);
+    int numEntries = numResStationsForFunctionalUnit(resStationTable, fuType);
+
+    for (int i = 0; i < numEntries; i++) {
+        if (entries[i]->busy) {
+            entries[i]->justGotOperandFromCDB = 0;
+        }
+    }
+}
+
+// returns 1 if a functional unit has work to do with its reservation stations in the next cycle, either starting an
+// instruction whose operands are ready or clearing the flag of one that just received an operand from the CDB
+int resStationsHaveWorkForFunctionalUnit(ResStationStatusTable *resStationTable, ROBStatusTable *robTable, enum FunctionalUnitType fuType) {
+
+    ResStationStatusTableEntry **entries = resStationEntriesForFunctionalUnit(resStationTable, fuType);
+    int numEntries = numResStationsForFunctionalUnit(resStationTable, fuType);
+
+    for (int i = 0; i < numEntries; i++) {
+        ResStationStatusTableEntry *entry = entries[i];
+
+        if (!entry->busy) {
+            continue;
+        }
+
+        if (entry->justGotOperandFromCDB) {
+            return 1;
+        }
+
+        // loads only need their base address operand
+        int operandsAreAvailable = fuType == FU_TYPE_LOAD ? entry->vkIsAvailable : entry->vjIsAvailable && entry->vkIsAvailable;
+        if (operandsAreAvailable && robTable->entries[entry->dest].state == INST_STATE_ISSUED) {
+            return 1;
+        }
+    }
+
+    return 0;
 }
\ No newline at end of file
@@ -5,6 +5,16 @@ typedef struct RegisterStatusTable RegisterStatusTable;
 typedef struct Instruction Instruction;
 typedef struct FloatFUResult FloatFUResult;
 typedef struct IntFUResult IntFUResult;
+typedef struct ROBStatusTable ROBStatusTable;
+typedef struct ResStationStatusTableEntry ResStationStatusTableEntry;
+typedef struct Params Params;
+
+// struct representing a reservation station operand that is waiting on the result of a ROB entry
+typedef struct ResStationOperandWaiter {
+    ResStationStatusTableEntry *entry;
+    int sourceNum; // 1 for vj, 2 for vk
+    struct ResStationOperandWaiter *next; // the next operand waiting on the same ROB entry
+} ResStationOperandWaiter;
 
 // struct representing the reservation status table's entries
 typedef struct ResStationStatusTableEntry {
@@ -24,6 +34,7 @@ typedef struct ResStationStatusTableEntry {
     int dest; // the ROB index that will hold the result
     int addr; // store base address information for loads/stores/branches
     int buOffset; // the offset stored in the BU instruction in order to calculate the effective address
+    ResStationOperandWaiter operandWaiters[2]; // list nodes used while vj / vk are waiting on a ROB entry
 
 } ResStationStatusTableEntry;
 
@@ -47,14 +58,26 @@ typedef struct ResStationStatusTable {
     int numFPDivStations;
     int numBUStations;
 
+    // the last reservation station selected by any of the units of each type, units resume selecting round robin after it
+    int lastSelectedIntStation;
+    int lastSelectedFPAddStation;
+    int lastSelectedFPMulStation;
+    int lastSelectedFPDivStation;
+    int lastSelectedBUStation;
+
+    // indexed by ROB index, lists the operands waiting on each ROB entry's result so results only visit their consumers
+    ResStationOperandWaiter **operandWaitersForROB;
+    int NR;
+
 } ResStationStatusTable;
 
 // reservation status table methods
 ResStationStatusTableEntry *newResStationStatusTableEntry();
-void initResStationStatusTable(ResStationStatusTable *resStationTable);
+void initResStationStatusTable(ResStationStatusTable *resStationTable, Params *params);
 void teardownResStationStatusTable(ResStationStatusTable *resStationTable);
 int numResStationsForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType);
 int numBusyResStationsForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType);
+int *lastSelectedResStationForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType);
 ResStationStatusTableEntry **resStationEntriesForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType);
 ResStationStatusTableEntry *resStationEntryForFunctionalUnitWithDestROB(ResStationStatusTable *resStationTable, int fuType, int destROB);
 ResStationStatusTableEntry **resStationEntriesForInstruction(ResStationStatusTable *resStationTable, Instruction *inst);
@@ -63,10 +86,14 @@ int indexForFreeResStationForInstruction(ResStationStatusTable *resStationTable,
 int isFreeResStationForInstruction(ResStationStatusTable *resStationTable, Instruction *inst);
 void addInstToResStation(ResStationStatusTable *resStationTable, RegisterStatusTable *regTable, RegisterFile *regFile, Instruction *inst, int destROB);
 void printResStationStatusTable(ResStationStatusTable *resStationTable);
-void setResStationEntryOperandAvailability(ResStationStatusTableEntry *entry, RegisterStatusTable *regTable, RegisterFile *regFile, 
-    int sourceNum, ArchRegister *reg, int renamedReg, int resultType);
-void processIntUpdateForResStationEntries(ResStationStatusTableEntry **entries, int numEntries, int destROB, int result, int fromCDB);
-void processFloatUpdateForResStationEntries(ResStationStatusTableEntry **entries, int numEntries, int destROB, float result, int fromCDB);
+void addOperandWaiterForROB(ResStationStatusTable *resStationTable, ResStationStatusTableEntry *entry, int sourceNum, int robIndex);
+void setResStationEntryOperandAvailability(ResStationStatusTable *resStationTable, ResStationStatusTableEntry *entry, RegisterStatusTable *regTable, 
+    RegisterFile *regFile, int sourceNum, ArchRegister *reg, int renamedReg, int resultType);
+void processIntUpdateForResStationOperand(ResStationOperandWaiter *waiter, int destROB, int result, int fromCDB);
+void processFloatUpdateForResStationOperand(ResStationOperandWaiter *waiter, int destROB, float result, int fromCDB);
+int numOperandsWaitingForROB(ResStationStatusTable *resStationTable, int robIndex);
 void sendIntUpdateToResStationStatusTable(ResStationStatusTable *resStationTable, int destROB, int result, int fromCDB);
 void sendFloatUpdateToResStationStatusTable(ResStationStatusTable *resStationTable, int destROB, float result, int fromCDB);
-void flushResStationStatusTable(ResStationStatusTable *resStationTable);
\ No newline at end of file
+void flushResStationStatusTable(ResStationStatusTable *resStationTable);
+void clearJustGotOperandFromCDBForFunctionalUnit(ResStationStatusTable *resStationTable, int fuType);
+int resStationsHaveWorkForFunctionalUnit(ResStationStatusTable *resStationTable, ROBStatusTable *robTable, int fuType);
\ No newline at end of file
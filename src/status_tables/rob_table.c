@@ -10,11 +10,13 @@ void initROBStatusTable(ROBStatusTable *robTable, int NR) {
 
     robTable->NR = NR;
     robTable->headEntryIndex = 0;
-    robTable->entries = malloc(NR * sizeof(ROBStatusTableEntry *));
+    robTable->tailEntryIndex = 0;
+    robTable->count = 0;
+    robTable->entries = malloc(NR * sizeof(ROBStatusTableEntry));
 
     // create empty entries in the ROB table
     for (int i = 0; i < NR; i++) {
-        ROBStatusTableEntry *entry = malloc(sizeof(ROBStatusTableEntry));
+        ROBStatusTableEntry *entry = &robTable->entries[i];
         entry->index = i;
         entry->busy = 0;
         entry->inst = NULL;
@@ -27,8 +29,6 @@ void initROBStatusTable(ROBStatusTable *robTable, int NR) {
         entry->fuType = FU_TYPE_NONE;
         entry->addr = -1;
         entry->flushed = 0;
-
-        robTable->entries[i] = entry;
     }
 }
 
@@ -36,32 +36,23 @@ void initROBStatusTable(ROBStatusTable *robTable, int NR) {
 void teardownROBStatusTable(ROBStatusTable *robTable) {
 
     if (robTable->entries) {
-        for (int i = 0; i < robTable->NR; i++) {
-            free(robTable->entries[i]);
-        }
         free(robTable->entries);
     }
 }
 
-// returns the index of the next available free slot in the ROB 
+// returns the index of the next available free slot in the ROB, entries are allocated in order at the tail
 int nextFreeROBEntryIndex(ROBStatusTable *robTable) {
 
-    // iterate over all entries in the ROB starting at the head
-    for (int i = 0; i < robTable->NR; i++) {
-        int index = (robTable->headEntryIndex + i) % robTable->NR;
-        ROBStatusTableEntry *entry = robTable->entries[index];
-
-        if (!entry->busy) {
-            return index;
-        }
+    if (robTable->count == robTable->NR) {
+        return -1;
     }
 
-    return -1;
+    return robTable->tailEntryIndex;
 }
 
 // returns 1 if there is an available slot in the ROB, 0 if it is full
 int isFreeEntryInROB(ROBStatusTable *robTable) {
-    return nextFreeROBEntryIndex(robTable) != -1;
+    return robTable->count < robTable->NR;
 }
 
 // adds an instruction to the ROB and returns the ROB index that will contain the result
@@ -69,7 +60,10 @@ int addInstToROB(ROBStatusTable *robTable, Instruction *inst) {
 
     // this method assumes that ROB availablility was checked before it was called
     int robIndex = nextFreeROBEntryIndex(robTable);
-    ROBStatusTableEntry *entry = robTable->entries[robIndex];
+    ROBStatusTableEntry *entry = &robTable->entries[robIndex];
+
+    robTable->tailEntryIndex = (robTable->tailEntryIndex + 1) % robTable->NR;
+    robTable->count++;
 
     entry->busy = 1;
     entry->inst = inst;
@@ -108,6 +102,12 @@ int addInstToROB(ROBStatusTable *robTable, Instruction *inst) {
     
     // add values to ROB for branch instruction
     } else if (instType == BNE) {
+        entry->instResultValueType = VALUE_TYPE_NONE;
+        entry->fuType = FU_TYPE_BU;
+
+    // add values to ROB for jumps, which write their return address unless it is discarded
+    } else if (instType == JAL || instType == JALR) {
+        entry->instResultValueType = inst->destReg ? VALUE_TYPE_INT : VALUE_TYPE_NONE;
         entry->fuType = FU_TYPE_BU;
     
     // handle error case
@@ -126,54 +126,62 @@ int addInstToROB(ROBStatusTable *robTable, Instruction *inst) {
 // prints the contents of the ROB status table
 void printROBStatusTable(ROBStatusTable *robTable) {
     
+    char regName[PHYS_REG_NAME_SIZE];
+
     printf("ROB status table: head entry index: %i\n", robTable->headEntryIndex);
 
     for (int i = 0; i < robTable->NR; i++) {
-        ROBStatusTableEntry *entry = robTable->entries[i];
+        ROBStatusTableEntry *entry = &robTable->entries[i];
         char *destStr = NULL;
         if (entry->destReg) {
             destStr = entry->destReg->name;
         }
         printf("\trobIndex: %i, busy: %i, inst: %s, dest: %s, renamedDest: %s, intVal: %i, floatVal: %f, ", entry->index, entry->busy, entry->inst ? entry->inst->fullStr : "null", destStr, 
-            physicalRegisterNameToString(entry->renamedDestReg), entry->intValue, entry->floatValue);
+            physicalRegisterNameToString(entry->renamedDestReg, regName), entry->intValue, entry->floatValue);
         printf("state: %s, resultType: %s, flushed: %i, addr: %i\n", instStateToString(entry->state), valueTypeToString(entry->instResultValueType), entry->flushed, entry->addr);
     }
 }
 
 // returns the ROB entry that is currently at the head
 ROBStatusTableEntry *getHeadROBEntry(ROBStatusTable *robTable) {
-    return robTable->entries[robTable->headEntryIndex];
+    return &robTable->entries[robTable->headEntryIndex];
 }
 
-// returns 1 if all robs in the ROB status table are not busy, 0 if any of them are busy
-int isROBEmpty(ROBStatusTable *robTable) {
+// frees the entry at the head of the ROB once it has committed and moves the head to the next entry
+void removeHeadEntryFromROB(ROBStatusTable *robTable) {
 
-    for (int i = 0; i < robTable->NR; i++) {
-        if (robTable->entries[i]->busy) {
-            return 0;
-        }
-    } 
+    if (robTable->count == 0) {
+        printf("error: tried to remove the head entry from an empty ROB\n");
+        return;
+    }
+
+    robTable->entries[robTable->headEntryIndex].busy = 0;
+    robTable->headEntryIndex = (robTable->headEntryIndex + 1) % robTable->NR;
+    robTable->count--;
+}
 
-    return 1;
+// returns 1 if all robs in the ROB status table are not busy, 0 if any of them are busy
+int isROBEmpty(ROBStatusTable *robTable) {
+    return robTable->count == 0;
 }
 
-// sets busy = 0 for all entries in the ROB
+// sets busy = 0 for all entries in the ROB except for the head
 void flushROB(ROBStatusTable *robTable) {
 
     printf_DEBUG(("flushing ROB...\n"));
 
-    for (int i = 0; i < robTable->NR; i++) {
-        ROBStatusTableEntry *entry = robTable->entries[i];
-        
-        if (entry->index == robTable->headEntryIndex) {
-            continue;
-        }
-        
-        if (entry->busy) {
-            entry->flushed = 1;
-            entry->busy = 0;
-        }
+    if (robTable->count == 0) {
+        return;
     }
+
+    for (int i = 1; i < robTable->count; i++) {
+        ROBStatusTableEntry *entry = &robTable->entries[(robTable->headEntryIndex + i) % robTable->NR];
+        entry->flushed = 1;
+        entry->busy = 0;
+    }
+
+    robTable->tailEntryIndex = (robTable->headEntryIndex + 1) % robTable->NR;
+    robTable->count = 1;
 }
 
 // helper method that returns how many entries away the given ROB index is from the head 
@@ -188,22 +196,4 @@ int indexDistanceToROBHead(ROBStatusTable *robTable, int index) {
     } else {
         return 0;
     }
-}
-
-// determines if there is a ROB that will write to a given physical register
-int physicalRegWillBeWrittenBySomeROB(ROBStatusTable *robTable, enum PhysicalRegisterName reg) {
-
-    if (reg == PHYS_REG_ZERO || reg == PHYS_REG_NONE || reg >= PHYS_REG_SIZE) {
-        return 0;
-    }
-
-    // iterative over ever ROB entry
-    for (int i = 0; i < robTable->NR; i++) {
-        ROBStatusTableEntry *entry = robTable->entries[i];
-        if (entry->busy && entry->renamedDestReg == reg) {
-            return 1;
-        }
-    }
-
-    return 0;
 }
\ No newline at end of file
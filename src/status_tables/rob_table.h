@@ -21,11 +21,13 @@ typedef struct ROBStatusTableEntry {
 
 } ROBStatusTableEntry;
 
-// struct representing the ROB status table
+// struct representing the ROB status table, a circular buffer where the busy entries are the count entries starting at the head
 typedef struct ROBStatusTable {
-    ROBStatusTableEntry **entries;
+    ROBStatusTableEntry *entries;
     int NR;
     int headEntryIndex;
+    int tailEntryIndex; // the next entry to be allocated
+    int count; // number of busy entries
 } ROBStatusTable;
 
 // ROB status table methods
@@ -36,7 +38,7 @@ int isFreeEntryInROB(ROBStatusTable *robTable);
 int nextFreeROBEntryIndex(ROBStatusTable *robTable);
 int addInstToROB(ROBStatusTable *robTable, Instruction *inst);
 ROBStatusTableEntry *getHeadROBEntry(ROBStatusTable *robTable);
+void removeHeadEntryFromROB(ROBStatusTable *robTable);
 int isROBEmpty(ROBStatusTable *robTable);
 void flushROB(ROBStatusTable *robTable);
-int indexDistanceToROBHead(ROBStatusTable *robTable, int index);
-int physicalRegWillBeWrittenBySomeROB(ROBStatusTable *robTable, int reg); // reg = enum PhysicalRegisterName
\ No newline at end of file
+int indexDistanceToROBHead(ROBStatusTable *robTable, int index);
\ No newline at end of file
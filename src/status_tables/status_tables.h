@@ -2,3 +2,4 @@
 #include "register_table.h"
 #include "res_station_table.h"
 #include "rob_table.h"
+#include "load_store_queue.h"